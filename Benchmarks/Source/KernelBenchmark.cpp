@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    KernelBenchmark.cpp
+    Created: 20 Oct 2026 9:48:31am
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "KernelBenchmark.h"
+#include "../../Source/GUI/AnalyzerKernels.h"
+#include <chrono>
+#include <cmath>
+#include <ostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    //what FFTDataGenerator did before magnitudesToDecibels() existed
+    void referenceMagnitudesToDecibels(float* data, int numBins, float negativeInfinity)
+    {
+        for( int i = 0; i < numBins; ++i )
+        {
+            auto v = data[i];
+            v = ( ! std::isinf(v) && ! std::isnan(v) ) ? v / static_cast<float>(numBins) : 0.f;
+            data[i] = juce::Decibels::gainToDecibels(v, negativeInfinity);
+        }
+    }
+    
+    template<typename Function>
+    double timeMicroseconds(int iterations, Function&& function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        
+        for( int i = 0; i < iterations; ++i )
+            function(i);
+        
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+    }
+}
+
+bool KernelBenchmark::run(std::ostream& out) const
+{
+    //every normal exponent, 4096 mantissas each
+    double log2Error = 0.0;
+    
+    for( int exponent = -126; exponent <= 127; ++exponent )
+    {
+        for( int step = 0; step < 4096; ++step )
+        {
+            auto x = std::ldexp(1.0f + step / 4096.f, exponent);
+            
+            if( ! std::isfinite(x) )
+                continue;
+            
+            auto error = std::abs(static_cast<double>(AnalyzerKernels::fastLog2(x)) - std::log2(static_cast<double>(x)));
+            log2Error = std::max(log2Error, error);
+        }
+    }
+    
+    const auto negativeInfinity = -72.f;
+    
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> exponents(-12.f, 6.f);
+    
+    double decibelError = 0.0;
+    
+    out << "fastLog2: max abs error " << log2Error << " (bound " << maxLog2Error << ")\n";
+    
+    for( int order : { 11, 12, 13 } )
+    {
+        const auto numBins = (1 << order) / 2;
+        
+        std::vector<float> magnitudes(static_cast<size_t>(numBins));
+        for( auto& magnitude : magnitudes )
+            magnitude = std::pow(10.f, exponents(random)) * numBins;
+        
+        magnitudes[3] = std::numeric_limits<float>::quiet_NaN();
+        magnitudes[5] = std::numeric_limits<float>::infinity();
+        magnitudes[7] = 0.f;
+        
+        auto expected = magnitudes;
+        auto actual = magnitudes;
+        
+        referenceMagnitudesToDecibels(expected.data(), numBins, negativeInfinity);
+        AnalyzerKernels::magnitudesToDecibels(actual.data(), numBins, negativeInfinity);
+        
+        for( size_t i = 0; i < expected.size(); ++i )
+            decibelError = std::max(decibelError, static_cast<double>(std::abs(expected[i] - actual[i])));
+        
+        //the copy back to the source is included in both, so only the difference means anything
+        std::vector<float> work(magnitudes.size());
+        
+        //volatile, so the optimiser can't drop the loops
+        volatile float sink = 0.f;
+        
+        auto referenceUs = timeMicroseconds(numTimingIterations, [&](int i)
+        {
+            work = magnitudes;
+            referenceMagnitudesToDecibels(work.data(), numBins, negativeInfinity);
+            sink = sink + work[static_cast<size_t>(i % numBins)];
+        });
+        
+        auto kernelUs = timeMicroseconds(numTimingIterations, [&](int i)
+        {
+            work = magnitudes;
+            AnalyzerKernels::magnitudesToDecibels(work.data(), numBins, negativeInfinity);
+            sink = sink + work[static_cast<size_t>(i % numBins)];
+        });
+        
+        out << "magnitudesToDecibels, order " << order << ": "
+            << referenceUs << "us -> " << kernelUs << "us per frame (" << referenceUs / kernelUs << "x)\n";
+    }
+    
+    out << "magnitudesToDecibels: max abs error " << decibelError << "dB (bound " << maxDecibelError << "dB)\n";
+    
+    return log2Error <= maxLog2Error && decibelError <= maxDecibelError;
+}
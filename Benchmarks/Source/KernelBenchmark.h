@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    KernelBenchmark.h
+    Created: 20 Oct 2026 9:48:31am
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <iosfwd>
+
+/*
+ Checks the accuracy of the AnalyzerKernels against the plain library maths they replace,
+ and times them against it.
+ 
+ - fastLog2() against std::log2 over every normal float exponent, 4096 mantissas each
+ - magnitudesToDecibels() against the loop it replaced (isinf/isnan, / numBins, gainToDecibels),
+   on random magnitudes from 1e-12 to 1e6 plus NaN, Inf and 0
+ 
+ The error bounds are the ones documented in AnalyzerKernels.h,
+ so a change to the polynomial that breaks them fails here.
+ */
+struct KernelBenchmark
+{
+    //documented in AnalyzerKernels.h. The log2 bound is for the whole normal range,
+    //the dB one for what an FFT gives (which stays well inside 2^-64..2^64).
+    static constexpr double maxLog2Error = 2.2e-5;
+    static constexpr double maxDecibelError = 1.0e-4;
+    
+    int numTimingIterations = 20000;
+    
+    //Prints a table to 'out', and returns false if either error bound was exceeded.
+    bool run(std::ostream& out) const;
+};
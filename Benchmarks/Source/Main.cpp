@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 20 Oct 2026 9:12:05am
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "KernelBenchmark.h"
+#include "RenderBenchmark.h"
+#include "../../Source/PluginProcessor.h"
+#include <iostream>
+
+/*
+ Runs the benchmarks without a display, and prints their tables.
+ 
+    SimpleMBCompBenchmarks              everything
+    SimpleMBCompBenchmarks kernels      only the AnalyzerKernels accuracy and speed check
+    SimpleMBCompBenchmarks render [n]   only the render benchmark, over n frames
+ 
+ Exits with 1 if the kernels are outside their documented error bounds.
+ */
+int main(int argc, char* argv[])
+{
+    const juce::String which = argc > 1 ? argv[1] : "";
+    
+    bool kernelsPassed = true;
+    
+    if( which.isEmpty() || which == "kernels" )
+    {
+        KernelBenchmark kernelBenchmark;
+        kernelsPassed = kernelBenchmark.run(std::cout);
+        
+        std::cout << (kernelsPassed ? "kernels: ok" : "kernels: ERROR BOUND EXCEEDED") << std::endl << std::endl;
+    }
+    
+    if( which.isNotEmpty() && which != "render" )
+        return kernelsPassed ? 0 : 1;
+    
+    //no display is needed: nothing is ever put on the desktop
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    RenderBenchmark benchmark;
+    
+    if( argc > 2 )
+        benchmark.numFrames = juce::jmax(1, juce::String(argv[2]).getIntValue());
+    
+    SimpleMBCompAudioProcessor processor;
+    
+    auto latency = benchmark.measureOpenLatency(processor, 10);
+    
+    std::cout << "editor open, first: " << latency.firstConstructionMs << "ms to construct, "
+              << latency.firstPaintMs << "ms to first paint" << std::endl;
+    std::cout << "editor open, reopened: " << latency.meanConstructionMs << "ms to construct, "
+              << latency.meanFirstPaintMs << "ms to first paint" << std::endl << std::endl;
+    
+    auto results = benchmark.run(processor,
+                                 {
+                                     { 0, 0, 900, 810 },
+                                     { 0, 0, 1200, 1080 },
+                                     { 0, 0, 1800, 1620 }
+                                 });
+    
+    std::cout << RenderBenchmark::formatResults(results) << std::flush;
+    return kernelsPassed ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+    RenderBenchmark.cpp
+    Created: 19 Oct 2026 9:40:16pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "RenderBenchmark.h"
+#include "../../Source/PluginEditor.h"
+#include <new>
+
+//==============================================================================
+//Every allocation in the process goes through these, so the benchmark can count them.
+//This file is only part of the benchmark app, so the plugin never replaces them.
+
+namespace
+{
+    //per thread, a plain integer needs no construction, so it is safe to touch from inside operator new
+    thread_local int64_t numAllocationsOnThisThread = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    ++numAllocationsOnThisThread;
+    
+    if( auto* p = std::malloc(size == 0 ? 1 : size) )
+        return p;
+    
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+int64_t RenderBenchmark::getNumAllocationsOnThisThread()
+{
+    return numAllocationsOnThisThread;
+}
+
+//==============================================================================
+
+std::vector<RenderBenchmark::Result> RenderBenchmark::run(SimpleMBCompAudioProcessor& processor,
+                                                          const std::vector<juce::Rectangle<int>>& editorSizes)
+{
+    using namespace juce;
+    
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+    
+    std::unique_ptr<AudioProcessorEditor> ownedEditor(processor.createEditor());
+    auto* editor = dynamic_cast<SimpleMBCompAudioProcessorEditor*>(ownedEditor.get());
+    jassert( editor != nullptr );
+    
+    //The analysis normally runs on the analyzer's own thread, woken by the frame.
+    //Here it runs inline, so every frame analyses exactly the audio fed to it.
+    auto& analyzer = editor->getAnalyzer();
+    analyzer.setAnalysisRunsOnThread(false);
+    
+    //vBlankCallback() posts work to the analyzer's pool (the FFT engines on the first frame,
+    //the cached layers after that). Paints are only timed once it's idle, so they don't share the CPU with it.
+    editor->vBlankCallback();
+    analyzer.waitForBackgroundWork();
+    
+    auto components = editor->getComponentsToProfile();
+    
+    //a slow sweep with some noise on top, so every band has something in it
+    AudioBuffer<float> buffer(processor.getTotalNumOutputChannels(), blockSize);
+    MidiBuffer midi;
+    Random random(1234);
+    double phase = 0.0, sweepPosition = 0.0;
+    
+    auto feedOneFrameOfAudio = [&]()
+    {
+        //one 60Hz display frame's worth
+        auto numBlocks = jmax(1, roundToInt(sampleRate / 60.0 / blockSize));
+        
+        for( int block = 0; block < numBlocks; ++block )
+        {
+            for( int i = 0; i < blockSize; ++i )
+            {
+                sweepPosition = std::fmod(sweepPosition + 1.0 / (sampleRate * 5.0), 1.0);
+                auto frequency = mapToLog10(static_cast<float>(sweepPosition), 20.f, 20000.f);
+                phase += MathConstants<double>::twoPi * frequency / sampleRate;
+                
+                auto sample = 0.5f * static_cast<float>(std::sin(phase)) + 0.05f * (random.nextFloat() * 2.f - 1.f);
+                
+                for( int channel = 0; channel < buffer.getNumChannels(); ++channel )
+                    buffer.setSample(channel, i, sample);
+            }
+            
+            processor.processBlock(buffer, midi);
+        }
+    };
+    
+    std::vector<Result> results;
+    std::vector<Image> images(components.size());
+    
+    for( auto size : editorSizes )
+    {
+        editor->setSize(size.getWidth(), size.getHeight());
+        
+        for( size_t i = 0; i < components.size(); ++i )
+        {
+            auto* component = components[i].second;
+            images[i] = component != nullptr && ! component->getLocalBounds().isEmpty() ?
+                        Image(Image::RGB, component->getWidth(), component->getHeight(), true, SoftwareImageType()) :
+                        Image();
+        }
+        
+        std::vector<Result> sizeResults(components.size());
+        std::vector<double> totalMicroseconds(components.size(), 0.0);
+        std::vector<int64_t> totalAllocations(components.size(), 0);
+        
+        for( int frame = 0; frame < numWarmUpFrames + numFrames; ++frame )
+        {
+            feedOneFrameOfAudio();
+            
+            analyzer.runAnalysis();
+            editor->vBlankCallback();
+            analyzer.waitForBackgroundWork();
+            
+            const bool measuring = frame >= numWarmUpFrames;
+            
+            for( size_t i = 0; i < components.size(); ++i )
+            {
+                if( images[i].isNull() )
+                    continue;
+                
+                auto allocationsBefore = getNumAllocationsOnThisThread();
+                auto start = Time::getHighResolutionTicks();
+                
+                {
+                    Graphics g(images[i]);
+                    components[i].second->paintEntireComponent(g, true);
+                }
+                
+                auto microseconds = 1.0e6 * Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+                auto allocations = getNumAllocationsOnThisThread() - allocationsBefore;
+                
+                if( measuring )
+                {
+                    totalMicroseconds[i] += microseconds;
+                    totalAllocations[i] += allocations;
+                    sizeResults[i].maxMicroseconds = jmax(sizeResults[i].maxMicroseconds, microseconds);
+                }
+            }
+        }
+        
+        for( size_t i = 0; i < components.size(); ++i )
+        {
+            if( images[i].isNull() )
+                continue;
+            
+            auto& result = sizeResults[i];
+            result.component = components[i].first;
+            result.editorWidth = size.getWidth();
+            result.editorHeight = size.getHeight();
+            result.meanMicroseconds = totalMicroseconds[i] / numFrames;
+            result.allocationsPerFrame = static_cast<double>(totalAllocations[i]) / numFrames;
+            
+            results.push_back(result);
+        }
+    }
+    
+    return results;
+}
+
+RenderBenchmark::OpenLatencyResult RenderBenchmark::measureOpenLatency(SimpleMBCompAudioProcessor& processor, int numOpens)
+{
+    using namespace juce;
+    
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+    
+    OpenLatencyResult result;
+    
+    for( int open = 0; open < numOpens; ++open )
+    {
+        std::unique_ptr<AudioProcessorEditor> ownedEditor(processor.createEditor());
+        auto* editor = dynamic_cast<SimpleMBCompAudioProcessorEditor*>(ownedEditor.get());
+        jassert( editor != nullptr );
+        
+        //what a host does first: one frame, then one paint of the whole window
+        editor->vBlankCallback();
+        
+        Image image(Image::RGB, editor->getWidth(), editor->getHeight(), true, SoftwareImageType());
+        {
+            Graphics g(image);
+            editor->paintEntireComponent(g, true);
+        }
+        
+        auto latency = editor->getOpenLatency();
+        
+        //the first open also pays for everything shared between editors, the rest show the steady cost
+        if( open == 0 )
+        {
+            result.firstConstructionMs = latency.constructionMs;
+            result.firstPaintMs = latency.firstPaintMs;
+        }
+        else
+        {
+            result.meanConstructionMs += latency.constructionMs / (numOpens - 1);
+            result.meanFirstPaintMs += latency.firstPaintMs / (numOpens - 1);
+        }
+    }
+    
+    return result;
+}
+
+juce::String RenderBenchmark::formatResults(const std::vector<Result>& results)
+{
+    using namespace juce;
+    
+    String text;
+    text << String("size").paddedRight(' ', 12)
+         << String("component").paddedRight(' ', 26)
+         << String("mean us").paddedLeft(' ', 10)
+         << String("max us").paddedLeft(' ', 10)
+         << String("allocs/frame").paddedLeft(' ', 14) << newLine;
+    
+    for( const auto& result : results )
+    {
+        text << (String(result.editorWidth) + "x" + String(result.editorHeight)).paddedRight(' ', 12)
+             << result.component.paddedRight(' ', 26)
+             << String(result.meanMicroseconds, 1).paddedLeft(' ', 10)
+             << String(result.maxMicroseconds, 1).paddedLeft(' ', 10)
+             << String(result.allocationsPerFrame, 1).paddedLeft(' ', 14) << newLine;
+    }
+    
+    return text;
+}
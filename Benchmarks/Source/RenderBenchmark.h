@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    RenderBenchmark.h
+    Created: 19 Oct 2026 9:40:16pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class SimpleMBCompAudioProcessor;
+
+/*
+ Renders the editor without a display and reports what each part of it costs to paint.
+ 
+ The processor is fed synthetic audio (a sweep plus noise) so the analyzer, meters and
+ gain reduction history all have something to draw. Every frame runs the editor's own
+ per-frame update, then paints each component on its own into an image with the
+ software renderer, timing it and counting the allocations it made.
+ 
+ It also opens and closes the editor a few times and reports how long that took,
+ using the editor's own getOpenLatency().
+ 
+ It is meant as a regression gate for the GUI hot paths: run it before and after a change
+ and compare the tables. It is built by Benchmarks/SimpleMBCompBenchmarks.jucer, never into the plugin.
+ */
+struct RenderBenchmark
+{
+    struct Result
+    {
+        juce::String component;
+        int editorWidth = 0, editorHeight = 0;
+        double meanMicroseconds = 0.0, maxMicroseconds = 0.0;
+        double allocationsPerFrame = 0.0;
+    };
+    
+    int numWarmUpFrames = 30;
+    int numFrames = 300;
+    double sampleRate = 48000.0;
+    int blockSize = 512;
+    
+    //Message thread. Creates its own editor for 'processor' and renders it at each size.
+    std::vector<Result> run(SimpleMBCompAudioProcessor& processor,
+                            const std::vector<juce::Rectangle<int>>& editorSizes);
+    
+    struct OpenLatencyResult
+    {
+        double firstConstructionMs = 0.0, firstPaintMs = 0.0;
+        double meanConstructionMs = 0.0, meanFirstPaintMs = 0.0;
+    };
+    
+    //Message thread. Opens the editor 'numOpens' times (at least 2), painting it once each time.
+    OpenLatencyResult measureOpenLatency(SimpleMBCompAudioProcessor& processor, int numOpens);
+    
+    static juce::String formatResults(const std::vector<Result>& results);
+    
+    //How many times operator new has been called on the calling thread.
+    //Other threads (the analysis thread, background jobs) aren't counted, so they can't leak into a paint's figures.
+    static int64_t getNumAllocationsOnThisThread();
+};
@@ -1,50 +1,168 @@
-/*
-  ==============================================================================
-
-    CompressorBand.cpp
-    Created: 27 Mar 2024 9:18:31pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#include "CompressorBand.h"
-
-void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
-{
-    compressor.prepare(spec);
-}
-
-void CompressorBand::updateCompressorSettings()
-{
-    //Before we process anything, we need to configure the parameters
-    compressor.setAttack(attack->get());
-    compressor.setRelease(release->get());
-    compressor.setThreshold(threshold->get());
-    compressor.setRatio(ratio->getCurrentChoiceName().getFloatValue()); //we need to extract the float value of the current choice from the array
-}
-
-void CompressorBand::process(juce::AudioBuffer<float>& buffer)
-{
-    auto preRMS = computeRMSLevel(buffer);
-    
-    auto block = juce::dsp::AudioBlock<float>(buffer); //create an audio block out of the buffer
-    auto context = juce::dsp::ProcessContextReplacing<float>(block); //create our context from the block
-    
-    //Next, we want to toggle whether or not the compressor processes the audio
-    //depending on the state of the bypass parameter.
-    //The easiest way to do this is by setting isBypassed,
-    //since there is already an if block in the process() function
-    //that will bypass processing if set to isBypassed is true.
-    
-    context.isBypassed = bypassed->get();
-    
-    compressor.process(context); //process the context with the compressor
-    
-    auto postRMS = computeRMSLevel(buffer);
-    
-    auto convertToDb = [](auto input){ return juce::Decibels::gainToDecibels(input); };
-    
-    rmsInputLevelDb.store(convertToDb(preRMS));
-    rmsOutputLevelDb.store(convertToDb(postRMS));
-}
+/*
+  ==============================================================================
+
+    CompressorBand.cpp
+    Created: 27 Mar 2024 9:18:31pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "CompressorBand.h"
+
+void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    compressor.prepare(spec);
+    
+    inputMeter.prepare(spec.sampleRate);
+    outputMeter.prepare(spec.sampleRate);
+    
+    gainReductionTelemetry.reset();
+    lastGain = 1.f;
+}
+
+void CompressorBand::updateCompressorSettings()
+{
+    //Before we process anything, we need to configure the parameters
+    thresholdDb = threshold->get();
+    ratioValue = ratio->getCurrentChoiceName().getFloatValue(); //we need to extract the float value of the current choice from the array
+    
+    compressor.setAttack(attack->get());
+    compressor.setRelease(release->get());
+    compressor.setThreshold(thresholdDb);
+    compressor.setRatio(ratioValue);
+}
+
+void CompressorBand::resetClipCounters()
+{
+    inputMeter.resetClips();
+    outputMeter.resetClips();
+}
+
+void CompressorBand::process(juce::AudioBuffer<float>& buffer)
+{
+    auto startTicks = juce::Time::getHighResolutionTicks();
+    
+    auto block = juce::dsp::AudioBlock<float>(buffer); //create an audio block out of the buffer
+    auto context = juce::dsp::ProcessContextReplacing<float>(block); //create our context from the block
+    
+    //Next, we want to toggle whether or not the compressor processes the audio
+    //depending on the state of the bypass parameter.
+    //The easiest way to do this is by setting isBypassed,
+    //since there is already an if block in the process() function
+    //that will bypass processing if set to isBypassed is true.
+    
+    context.isBypassed = bypassed->get();
+    
+    BlockLevels levels;
+    
+    if( context.isBypassed )
+    {
+        compressor.process(context); //process the context with the compressor
+        gainReductionTelemetry.addSamples(1.f, buffer.getNumSamples());
+        
+        //the output is the input, so it's only measured once
+        levels.rmsInput = levels.rmsOutput = computeRMSLevel(buffer);
+        levels.peakInput = levels.peakOutput = computePeakLevel(buffer);
+        
+        //and the meters still have to keep moving
+        inputMeter.addBlock(buffer);
+        outputMeter.addBlock(buffer);
+    }
+    else
+    {
+        levels = processWithTelemetry(buffer);
+    }
+    
+    auto convertToDb = [](auto input){ return juce::Decibels::gainToDecibels(input); };
+    
+    meterReading.rmsInputDb = convertToDb(levels.rmsInput);
+    meterReading.rmsOutputDb = convertToDb(levels.rmsOutput);
+    meterReading.peakInputDb = convertToDb(levels.peakInput);
+    meterReading.peakOutputDb = convertToDb(levels.peakOutput);
+    meterReading.gainReductionDb = convertToDb(levels.minGain);
+    meterReading.detectorLevelDb = computeDetectorLevelDb(levels);
+    meterReading.inputBallistics = inputMeter.getReading();
+    meterReading.outputBallistics = outputMeter.getReading();
+    
+    auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    meterReading.processingMicroseconds = static_cast<float>(elapsedSeconds * 1.0e6);
+}
+
+CompressorBand::BlockLevels CompressorBand::processWithTelemetry(juce::AudioBuffer<float>& buffer)
+{
+    //This does the same as compressor.process(), but sample by sample across the channels,
+    //so the gain applied to every sample can be recorded.
+    //The compressor only ever scales its input, so output / input is exactly that gain.
+    //The block's levels are measured on the way through, rather than in passes of their own.
+    
+    const auto numChannels = buffer.getNumChannels();
+    const auto numSamples = buffer.getNumSamples();
+    
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    
+    BlockLevels levels;
+    auto inputEnergy = 0.f, outputEnergy = 0.f;
+    
+    for( int i = 0; i < numSamples; ++i )
+    {
+        auto gain = 1.f;
+        bool hasSignal = false;
+        auto loudestInput = 0.f, loudestOutput = 0.f;
+        
+        for( int channel = 0; channel < numChannels; ++channel )
+        {
+            auto input = channels[channel][i];
+            loudestInput = juce::jmax(loudestInput, std::abs(input));
+            inputEnergy += input * input;
+            
+            auto output = compressor.processSample(channel, input);
+            channels[channel][i] = output;
+            loudestOutput = juce::jmax(loudestOutput, std::abs(output));
+            outputEnergy += output * output;
+            
+            //the most reduction of any channel, like a linked meter would show
+            if( std::abs(input) > 1.0e-6f )
+            {
+                gain = juce::jmin(gain, output / input);
+                hasSignal = true;
+            }
+        }
+        
+        //on silence the ratio is meaningless, so the last known gain is held
+        if( hasSignal )
+            lastGain = gain;
+        
+        gainReductionTelemetry.addSample(lastGain);
+        
+        levels.minGain = juce::jmin(levels.minGain, lastGain);
+        levels.peakInput = juce::jmax(levels.peakInput, loudestInput);
+        levels.peakOutput = juce::jmax(levels.peakOutput, loudestOutput);
+        
+        inputMeter.addSample(loudestInput);
+        outputMeter.addSample(loudestOutput);
+    }
+    
+    auto numValues = static_cast<float>(numChannels * numSamples);
+    
+    if( numValues > 0.f )
+    {
+        levels.rmsInput = std::sqrt(inputEnergy / numValues);
+        levels.rmsOutput = std::sqrt(outputEnergy / numValues);
+    }
+    
+    return levels;
+}
+
+float CompressorBand::computeDetectorLevelDb(const BlockLevels& levels) const
+{
+    //juce::dsp::Compressor keeps its envelope to itself, but above the threshold its gain is
+    //(envelope / threshold)^(1 / ratio - 1), so the envelope can be worked back out of the gain.
+    //The lowest gain of the block goes with the loudest the envelope got.
+    if( levels.minGain < 1.f && ratioValue > 1.f )
+        return thresholdDb + juce::Decibels::gainToDecibels(levels.minGain) / (1.f / ratioValue - 1.f);
+    
+    //Not reducing, so the envelope stayed at or below the threshold.
+    //It follows the input's peaks, which is the nearest there is to it.
+    return juce::jmin(thresholdDb, juce::Decibels::gainToDecibels(levels.peakInput));
+}
@@ -1,56 +1,104 @@
-/*
-  ==============================================================================
-
-    CompressorBand.h
-    Created: 27 Mar 2024 9:18:31pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "../Utilities.h"
-
-struct CompressorBand
-{
-    //We will want some easily accessible versions of our parameters.
-    //There's an APVTS member function to do this,
-    //but it would be very costly to do this in the process block,
-    //so instead let's store them in member variables
-    juce::AudioParameterFloat* attack { nullptr };
-    juce::AudioParameterFloat* release { nullptr };
-    juce::AudioParameterFloat* threshold { nullptr };
-    juce::AudioParameterChoice* ratio { nullptr };
-    juce::AudioParameterBool* bypassed { nullptr };
-    juce::AudioParameterBool* solo { nullptr };
-    juce::AudioParameterBool* mute { nullptr };
-    
-    void prepare(const juce::dsp::ProcessSpec& spec);
-    
-    void updateCompressorSettings();
-    
-    void process(juce::AudioBuffer<float>& buffer);
-    
-    float getRMSInputLevelDb() const { return rmsInputLevelDb; }
-    float getRMSOutputLevelDb() const { return rmsOutputLevelDb; }
-    
-private:
-    juce::dsp::Compressor<float> compressor;
-    std::atomic<float> rmsInputLevelDb { NEGATIVE_INFINITY };
-    std::atomic<float> rmsOutputLevelDb { NEGATIVE_INFINITY };
-    
-    template<typename T>
-    float computeRMSLevel(const T& buffer)
-    {
-        int numChannels = static_cast<int>(buffer.getNumChannels());
-        int numSamples = static_cast<int>(buffer.getNumSamples());
-        auto rms = 0.f;
-        for( int chan = 0; chan < numChannels; ++chan )
-        {
-            rms += buffer.getRMSLevel(chan, 0, numSamples);
-        }
-        rms /= static_cast<float>(numChannels);
-        return rms;
-    }
-};
+/*
+  ==============================================================================
+
+    CompressorBand.h
+    Created: 27 Mar 2024 9:18:31pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utilities.h"
+#include "GainReductionTelemetry.h"
+#include "MeterTelemetry.h"
+
+struct CompressorBand
+{
+    //We will want some easily accessible versions of our parameters.
+    //There's an APVTS member function to do this,
+    //but it would be very costly to do this in the process block,
+    //so instead let's store them in member variables
+    juce::AudioParameterFloat* attack { nullptr };
+    juce::AudioParameterFloat* release { nullptr };
+    juce::AudioParameterFloat* threshold { nullptr };
+    juce::AudioParameterChoice* ratio { nullptr };
+    juce::AudioParameterBool* bypassed { nullptr };
+    juce::AudioParameterBool* solo { nullptr };
+    juce::AudioParameterBool* mute { nullptr };
+    
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    
+    void updateCompressorSettings();
+    
+    void process(juce::AudioBuffer<float>& buffer);
+    
+    //audio thread. What the last process() call measured, the processor publishes it with the other bands'.
+    const BandMeterReading& getMeterReading() const { return meterReading; }
+    
+    //audio thread
+    void resetClipCounters();
+    
+    //The gain reduction of every sample, decimated into min/max records for the GUI
+    GainReductionTelemetry& getGainReductionTelemetry() { return gainReductionTelemetry; }
+    
+private:
+    juce::dsp::Compressor<float> compressor;
+    
+    //what the compressor was last set to, in the units it uses
+    float thresholdDb = 0.f;
+    float ratioValue = 1.f;
+    
+    BandMeterReading meterReading;
+    
+    //fed from the same per-sample loop as the compressor, see processWithTelemetry()
+    MeterBallistics inputMeter, outputMeter;
+    
+    GainReductionTelemetry gainReductionTelemetry;
+    
+    //the gain of the last sample that wasn't silent in every channel
+    float lastGain = 1.f;
+    
+    //the levels of one block, linear
+    struct BlockLevels
+    {
+        float rmsInput = 0.f, rmsOutput = 0.f;
+        float peakInput = 0.f, peakOutput = 0.f;
+        
+        //the lowest gain applied to any sample
+        float minGain = 1.f;
+    };
+    
+    //compresses the buffer and measures it in the same pass
+    BlockLevels processWithTelemetry(juce::AudioBuffer<float>& buffer);
+    
+    float computeDetectorLevelDb(const BlockLevels& levels) const;
+    
+    template<typename T>
+    float computeRMSLevel(const T& buffer)
+    {
+        //the energy of all channels together, the same as processWithTelemetry() measures
+        int numChannels = static_cast<int>(buffer.getNumChannels());
+        int numSamples = static_cast<int>(buffer.getNumSamples());
+        auto meanSquare = 0.f;
+        for( int chan = 0; chan < numChannels; ++chan )
+        {
+            auto rms = buffer.getRMSLevel(chan, 0, numSamples);
+            meanSquare += rms * rms;
+        }
+        meanSquare /= static_cast<float>(juce::jmax(1, numChannels));
+        return std::sqrt(meanSquare);
+    }
+    
+    template<typename T>
+    float computePeakLevel(const T& buffer)
+    {
+        auto peak = 0.f;
+        for( int chan = 0; chan < buffer.getNumChannels(); ++chan )
+        {
+            peak = juce::jmax(peak, buffer.getMagnitude(chan, 0, buffer.getNumSamples()));
+        }
+        return peak;
+    }
+};
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    GainReductionTelemetry.h
+    Created: 19 Oct 2026 6:37:14pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ The range of a band's gain reduction over one record's worth of samples, in dB.
+ Plain data, so records can go through the ring without locks or allocation.
+ */
+struct GainReductionRecord
+{
+    float minDb = 0.f; //the most gain reduction, i.e. the most negative value
+    float maxDb = 0.f; //the least
+};
+
+/*
+ Collects the gain a compressor applies, sample by sample, on the audio thread,
+ and writes one GainReductionRecord per 'samplesPerRecord' samples into a
+ lock-free single producer/single consumer ring.
+ 
+ The GUI reads every record, so nothing that happens between two repaints is lost.
+ */
+struct GainReductionTelemetry
+{
+    //at 48kHz this is 750 records per second
+    static constexpr int samplesPerRecord = 64;
+    
+    //a little over 5 seconds at 48kHz, if the GUI stalls longer than that, the newest records are dropped
+    static constexpr int capacity = 4096;
+    
+    //audio thread
+    void reset()
+    {
+        minGain = maxGain = 1.f;
+        numSamplesInRecord = 0;
+    }
+    
+    void addSample(float gain)
+    {
+        minGain = juce::jmin(minGain, gain);
+        maxGain = juce::jmax(maxGain, gain);
+        
+        if( ++numSamplesInRecord == samplesPerRecord )
+            writeRecord();
+    }
+    
+    //for blocks where the gain is constant, i.e. when bypassed
+    void addSamples(float gain, int numSamples)
+    {
+        while( numSamples > 0 )
+        {
+            auto numToAdd = juce::jmin(numSamples, samplesPerRecord - numSamplesInRecord);
+            
+            minGain = juce::jmin(minGain, gain);
+            maxGain = juce::jmax(maxGain, gain);
+            
+            numSamplesInRecord += numToAdd;
+            numSamples -= numToAdd;
+            
+            if( numSamplesInRecord == samplesPerRecord )
+                writeRecord();
+        }
+    }
+    
+    //message thread
+    int getNumRecordsAvailable() const { return fifo.getNumReady(); }
+    
+    /**
+     Reads up to 'maxNumRecords' records, oldest first, and hands each one to 'callback'.
+     Returns how many were read.
+     */
+    template<typename Callback>
+    int readRecords(int maxNumRecords, Callback&& callback)
+    {
+        const juce::AbstractFifo::ScopedRead read(fifo, maxNumRecords);
+        
+        for( int i = 0; i < read.blockSize1; ++i )
+            callback(records[static_cast<size_t>(read.startIndex1 + i)]);
+        
+        for( int i = 0; i < read.blockSize2; ++i )
+            callback(records[static_cast<size_t>(read.startIndex2 + i)]);
+        
+        return read.blockSize1 + read.blockSize2;
+    }
+    
+    //Throws away every record waiting to be read, e.g. the backlog that piled up while nothing was reading
+    void discardRecords()
+    {
+        readRecords(getNumRecordsAvailable(), [](const GainReductionRecord&) {});
+    }
+private:
+    juce::AbstractFifo fifo { capacity };
+    std::array<GainReductionRecord, capacity> records;
+    
+    float minGain = 1.f, maxGain = 1.f;
+    int numSamplesInRecord = 0;
+    
+    void writeRecord()
+    {
+        const juce::AbstractFifo::ScopedWrite write(fifo, 1);
+        
+        //the ring is full, the GUI isn't keeping up, so this record is dropped
+        if( write.blockSize1 > 0 )
+        {
+            auto& record = records[static_cast<size_t>(write.startIndex1)];
+            record.minDb = juce::Decibels::gainToDecibels(minGain);
+            record.maxDb = juce::Decibels::gainToDecibels(maxGain);
+        }
+        
+        reset();
+    }
+};
@@ -0,0 +1,322 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: 19 Oct 2026 7:41:03pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+
+void LoudnessMeter::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    using namespace juce;
+    
+    /*
+     BS.1770 only lists the K-weighting coefficients for 48kHz.
+     These are the analog prototypes they come from, so they can be redone for any rate.
+     */
+    const auto sampleRate = spec.sampleRate;
+    
+    {
+        //the high shelf, roughly +4dB above 1.5kHz
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        
+        auto k = std::tan(MathConstants<double>::pi * f0 / sampleRate);
+        auto vh = std::pow(10.0, gainDb / 20.0);
+        auto vb = std::pow(vh, 0.4996667741545416);
+        auto a0 = 1.0 + k / q + k * k;
+        
+        preFilter.b0 = static_cast<float>((vh + vb * k / q + k * k) / a0);
+        preFilter.b1 = static_cast<float>(2.0 * (k * k - vh) / a0);
+        preFilter.b2 = static_cast<float>((vh - vb * k / q + k * k) / a0);
+        preFilter.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        preFilter.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+    
+    {
+        //the RLB high pass, around 38Hz
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        
+        auto k = std::tan(MathConstants<double>::pi * f0 / sampleRate);
+        auto a0 = 1.0 + k / q + k * k;
+        
+        rlbFilter.b0 = 1.f;
+        rlbFilter.b1 = -2.f;
+        rlbFilter.b2 = 1.f;
+        rlbFilter.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        rlbFilter.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+    
+    samplesPerBlock = jmax(1, roundToInt(sampleRate * 0.1));
+    
+    resetState();
+}
+
+void LoudnessMeter::process(const juce::AudioBuffer<float>& buffer)
+{
+    if( resetRequested.exchange(false) )
+        resetState();
+    
+    const auto numChannels = juce::jmin(maxChannels, buffer.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+    
+    if( samplesPerBlock == 0 || numChannels == 0 )
+        return;
+    
+    for( int channel = 0; channel < numChannels; ++channel )
+    {
+        auto channelPeak = processTruePeak(buffer.getReadPointer(channel), numSamples, truePeakState[channel]);
+        peak = juce::jmax(peak, channelPeak);
+    }
+    
+    truePeak.store(juce::Decibels::gainToDecibels(peak, -std::numeric_limits<float>::infinity()));
+    
+    //the host's blocks don't line up with the 100ms ones, so the buffer is cut at their edges
+    int start = 0;
+    while( start < numSamples )
+    {
+        auto numToProcess = juce::jmin(numSamples - start, samplesPerBlock - samplesInBlock);
+        
+        for( int channel = 0; channel < numChannels; ++channel )
+        {
+            //both channels weigh 1.0, so their energies just add
+            blockEnergy += processKWeighting(buffer.getReadPointer(channel, start), numToProcess, kWeightingState[channel]);
+        }
+        
+        start += numToProcess;
+        samplesInBlock += numToProcess;
+        
+        if( samplesInBlock == samplesPerBlock )
+        {
+            addBlock(blockEnergy / samplesPerBlock);
+            
+            blockEnergy = 0.0;
+            samplesInBlock = 0;
+        }
+    }
+}
+
+void LoudnessMeter::resetState()
+{
+    kWeightingState.fill({});
+    
+    for( auto& state : truePeakState )
+    {
+        state.history.fill(0.f);
+        state.writeIndex = 0;
+    }
+    
+    samplesInBlock = 0;
+    blockEnergy = 0.0;
+    
+    blockHistory.fill(0.0);
+    newestBlock = 0;
+    numBlocks = 0;
+    
+    histogram.fill({});
+    
+    peak = 0.f;
+    
+    const auto negativeInfinity = -std::numeric_limits<float>::infinity();
+    momentaryLoudness.store(negativeInfinity);
+    shortTermLoudness.store(negativeInfinity);
+    integratedLoudness.store(negativeInfinity);
+    truePeak.store(negativeInfinity);
+}
+
+float LoudnessMeter::processKWeighting(const float* samples, int numSamples, KWeightingState& state) const
+{
+    /*
+     Both stages run in the same pass, and the squares are summed as they come out,
+     so the weighted signal never has to be stored anywhere.
+     The state lives in locals for the loop, so it stays in registers.
+     */
+    const auto pre = preFilter;
+    const auto rlb = rlbFilter;
+    
+    auto pre1 = state.pre1, pre2 = state.pre2;
+    auto rlb1 = state.rlb1, rlb2 = state.rlb2;
+    
+    float energy = 0.f;
+    
+    for( int i = 0; i < numSamples; ++i )
+    {
+        auto x = samples[i];
+        
+        auto y = pre.b0 * x + pre1;
+        pre1 = pre.b1 * x - pre.a1 * y + pre2;
+        pre2 = pre.b2 * x - pre.a2 * y;
+        
+        auto z = rlb.b0 * y + rlb1;
+        rlb1 = rlb.b1 * y - rlb.a1 * z + rlb2;
+        rlb2 = rlb.b2 * y - rlb.a2 * z;
+        
+        energy += z * z;
+    }
+    
+    //keep denormals out of the state once the input goes quiet
+    auto flush = [](float v) { return std::abs(v) < 1.0e-15f ? 0.f : v; };
+    
+    state.pre1 = flush(pre1);
+    state.pre2 = flush(pre2);
+    state.rlb1 = flush(rlb1);
+    state.rlb2 = flush(rlb2);
+    
+    return energy;
+}
+
+float LoudnessMeter::processTruePeak(const float* samples, int numSamples, TruePeakState& state) const
+{
+    const auto& phases = getTruePeakPhases();
+    
+    float maxMagnitude = 0.f;
+    
+    for( int i = 0; i < numSamples; ++i )
+    {
+        state.history[state.writeIndex] = state.history[state.writeIndex + tapsPerPhase] = samples[i];
+        state.writeIndex = (state.writeIndex + 1) % tapsPerPhase;
+        
+        //oldest first, the newest sample is x[tapsPerPhase - 1]
+        const auto* x = state.history.data() + state.writeIndex;
+        
+        for( const auto& phase : phases )
+        {
+            float sum = 0.f;
+            for( int tap = 0; tap < tapsPerPhase; ++tap )
+                sum += phase[tap] * x[tap];
+            
+            maxMagnitude = juce::jmax(maxMagnitude, std::abs(sum));
+        }
+    }
+    
+    return maxMagnitude;
+}
+
+const std::array<LoudnessMeter::Phase, LoudnessMeter::oversamplingFactor>& LoudnessMeter::getTruePeakPhases()
+{
+    static const auto phases = []()
+    {
+        /*
+         A 48 tap low pass at the original Nyquist, Blackman windowed and centred on tap 24,
+         so phase 0 gives back the input samples exactly and the other phases fall between them.
+         Tap n belongs to phase n % 4.
+         */
+        constexpr int numTaps = oversamplingFactor * tapsPerPhase;
+        constexpr int centre = numTaps / 2;
+        
+        std::array<Phase, oversamplingFactor> p { };
+        
+        for( int n = 0; n < numTaps; ++n )
+        {
+            auto k = n - centre;
+            auto x = juce::MathConstants<double>::pi * k / oversamplingFactor;
+            
+            auto sinc = k == 0 ? 1.0 : std::sin(x) / x;
+            auto phase = juce::MathConstants<double>::twoPi * n / numTaps;
+            auto window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+            
+            //stored back to front, so each phase is a plain dot product with the oldest-first history
+            p[n % oversamplingFactor][tapsPerPhase - 1 - n / oversamplingFactor] = static_cast<float>(sinc * window);
+        }
+        
+        //each phase should pass DC at unity gain
+        for( auto& phaseTaps : p )
+        {
+            double sum = 0.0;
+            for( auto tap : phaseTaps )
+                sum += tap;
+            
+            for( auto& tap : phaseTaps )
+                tap = static_cast<float>(tap / sum);
+        }
+        
+        return p;
+    }();
+    
+    return phases;
+}
+
+void LoudnessMeter::addBlock(double meanSquare)
+{
+    newestBlock = (newestBlock + 1) % blocksPerShortTerm;
+    blockHistory[newestBlock] = meanSquare;
+    numBlocks = juce::jmin(numBlocks + 1, blocksPerShortTerm);
+    
+    auto sumOfNewest = [this](int count)
+    {
+        double sum = 0.0;
+        for( int i = 0; i < count; ++i )
+            sum += blockHistory[(newestBlock - i + blocksPerShortTerm) % blocksPerShortTerm];
+        
+        return sum;
+    };
+    
+    auto momentary = sumOfNewest(blocksPerMomentary) / blocksPerMomentary;
+    
+    momentaryLoudness.store(energyToLoudness(momentary));
+    shortTermLoudness.store(energyToLoudness(sumOfNewest(blocksPerShortTerm) / blocksPerShortTerm));
+    
+    //every 100ms, the last 400ms are a gating block, 75% overlapped with the previous one
+    if( numBlocks < blocksPerMomentary )
+        return;
+    
+    auto loudness = energyToLoudness(momentary);
+    if( loudness <= absoluteGate )
+        return;
+    
+    auto& bin = histogram[static_cast<size_t>(getHistogramBin(loudness))];
+    ++bin.count;
+    bin.energy += momentary;
+    
+    updateIntegratedLoudness();
+}
+
+void LoudnessMeter::updateIntegratedLoudness()
+{
+    //the mean of everything above the absolute gate sets the relative gate
+    int count = 0;
+    double energy = 0.0;
+    
+    for( const auto& bin : histogram )
+    {
+        count += bin.count;
+        energy += bin.energy;
+    }
+    
+    if( count == 0 )
+        return;
+    
+    auto firstBin = getHistogramBin(energyToLoudness(energy / count) + relativeGate);
+    
+    count = 0;
+    energy = 0.0;
+    
+    for( int i = firstBin; i < numHistogramBins; ++i )
+    {
+        count += histogram[static_cast<size_t>(i)].count;
+        energy += histogram[static_cast<size_t>(i)].energy;
+    }
+    
+    if( count > 0 )
+        integratedLoudness.store(energyToLoudness(energy / count));
+}
+
+float LoudnessMeter::energyToLoudness(double meanSquare)
+{
+    if( meanSquare <= 0.0 )
+        return -std::numeric_limits<float>::infinity();
+    
+    return static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare));
+}
+
+int LoudnessMeter::getHistogramBin(float loudness)
+{
+    auto bin = static_cast<int>(std::floor((loudness - absoluteGate) / histogramBinWidth));
+    return juce::jlimit(0, numHistogramBins - 1, bin);
+}
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: 19 Oct 2026 7:41:03pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+/*
+ ITU-R BS.1770 loudness and true peak, for the plugin's stereo output.
+ 
+ The audio thread runs process() on every block. It K-weights the signal,
+ sums its energy into 100ms blocks and keeps the last 3 seconds of those blocks
+ for the momentary (400ms) and short-term (3s) loudness.
+ 
+ Integrated loudness needs every gating block since the last reset. Instead of keeping them,
+ they are counted into a histogram of 0.1 LU wide bins, which keeps the memory fixed
+ no matter how long the meter runs. The bins also hold the energy that went into them,
+ so the gated mean is exact, only the relative gate's position is rounded to a bin.
+ 
+ The results are atomics, the GUI can read them whenever it likes.
+ */
+struct LoudnessMeter
+{
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void process(const juce::AudioBuffer<float>& buffer);
+    
+    //any thread. The audio thread does the actual reset at the start of its next block.
+    void reset() { resetRequested.store(true); }
+    
+    //any thread. All in LUFS, apart from the true peak, which is in dBTP.
+    float getMomentaryLoudness() const { return momentaryLoudness.load(); }
+    float getShortTermLoudness() const { return shortTermLoudness.load(); }
+    float getIntegratedLoudness() const { return integratedLoudness.load(); }
+    float getTruePeak() const { return truePeak.load(); }
+private:
+    static constexpr int maxChannels = 2;
+    
+    //BS.1770 measures in 100ms steps, momentary is 4 steps, short-term is 30
+    static constexpr int blocksPerMomentary = 4;
+    static constexpr int blocksPerShortTerm = 30;
+    
+    //the gating histogram, from the absolute gate up to +10 LUFS, 0.1 LU per bin
+    static constexpr float absoluteGate = -70.f;
+    static constexpr float relativeGate = -10.f;
+    static constexpr float histogramBinWidth = 0.1f;
+    static constexpr int numHistogramBins = 800;
+    
+    struct Biquad
+    {
+        float b0 = 1.f, b1 = 0.f, b2 = 0.f, a1 = 0.f, a2 = 0.f;
+    };
+    
+    //the two K-weighting stages, a high shelf and the RLB high pass
+    Biquad preFilter, rlbFilter;
+    
+    //transposed direct form II state, two values per stage per channel
+    struct KWeightingState
+    {
+        float pre1 = 0.f, pre2 = 0.f, rlb1 = 0.f, rlb2 = 0.f;
+    };
+    std::array<KWeightingState, maxChannels> kWeightingState;
+    
+    /*
+     4x oversampling for the true peak, as a polyphase FIR:
+     each of the 4 phases computes one of the in-between samples from the last 12 inputs.
+     */
+    static constexpr int oversamplingFactor = 4;
+    static constexpr int tapsPerPhase = 12;
+    
+    struct TruePeakState
+    {
+        //stored twice, so the newest tapsPerPhase samples are always contiguous
+        std::array<float, 2 * tapsPerPhase> history;
+        int writeIndex = 0;
+    };
+    std::array<TruePeakState, maxChannels> truePeakState;
+    
+    using Phase = std::array<float, tapsPerPhase>;
+    static const std::array<Phase, oversamplingFactor>& getTruePeakPhases();
+    
+    //the current 100ms block
+    int samplesPerBlock = 0;
+    int samplesInBlock = 0;
+    double blockEnergy = 0.0;
+    
+    //the mean square of the most recent 100ms blocks, newest at 'newestBlock'
+    std::array<double, blocksPerShortTerm> blockHistory;
+    int newestBlock = 0;
+    int numBlocks = 0;
+    
+    struct HistogramBin
+    {
+        int count = 0;
+        double energy = 0.0;
+    };
+    std::array<HistogramBin, numHistogramBins> histogram;
+    
+    float peak = 0.f;
+    
+    std::atomic<bool> resetRequested { false };
+    std::atomic<float> momentaryLoudness { -std::numeric_limits<float>::infinity() };
+    std::atomic<float> shortTermLoudness { -std::numeric_limits<float>::infinity() };
+    std::atomic<float> integratedLoudness { -std::numeric_limits<float>::infinity() };
+    std::atomic<float> truePeak { -std::numeric_limits<float>::infinity() };
+    
+    void resetState();
+    
+    //K-weights one channel of a block and returns its energy, i.e. the sum of the squares
+    float processKWeighting(const float* samples, int numSamples, KWeightingState& state) const;
+    
+    //returns the highest magnitude between and on the samples
+    float processTruePeak(const float* samples, int numSamples, TruePeakState& state) const;
+    
+    void addBlock(double meanSquare);
+    void updateIntegratedLoudness();
+    
+    static float energyToLoudness(double meanSquare);
+    static int getHistogramBin(float loudness);
+};
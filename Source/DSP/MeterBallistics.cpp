@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    MeterBallistics.cpp
+    Created: 19 Oct 2026 11:31:52pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "MeterBallistics.h"
+
+void MeterBallistics::prepare(double sampleRate)
+{
+    const auto stepSeconds = static_cast<float>(samplesPerStep / sampleRate);
+    
+    ppmAttack = 1.f - std::exp(-stepSeconds / ppmIntegrationSeconds);
+    fallFactor = juce::Decibels::decibelsToGain(-ppmFallDbPerSecond * stepSeconds);
+    vuCoefficient = 1.f - std::exp(-stepSeconds / vuIntegrationSeconds);
+    peakHoldSteps = static_cast<int>(std::ceil(peakHoldSeconds / stepSeconds));
+    
+    reset();
+}
+
+void MeterBallistics::reset()
+{
+    stepPeak = stepEnergy = 0.f;
+    numStepClips = numSamplesInStep = 0;
+    
+    ppm = vuMeanSquare = heldPeak = 0.f;
+    numStepsHeld = 0;
+    
+    reading = {};
+}
+
+void MeterBallistics::addBlock(const juce::AudioBuffer<float>& buffer)
+{
+    const auto numChannels = buffer.getNumChannels();
+    const auto numSamples = buffer.getNumSamples();
+    
+    auto* const* channels = buffer.getArrayOfReadPointers();
+    
+    for( int i = 0; i < numSamples; ++i )
+    {
+        auto magnitude = 0.f;
+        
+        for( int channel = 0; channel < numChannels; ++channel )
+            magnitude = juce::jmax(magnitude, std::abs(channels[channel][i]));
+        
+        addSample(magnitude);
+    }
+}
+
+void MeterBallistics::advance()
+{
+    //a PPM rises quickly towards the peak, and falls at a fixed rate in dB
+    if( stepPeak > ppm )
+        ppm += (stepPeak - ppm) * ppmAttack;
+    else
+        ppm = juce::jmax(stepPeak, ppm * fallFactor);
+    
+    vuMeanSquare += (stepEnergy / samplesPerStep - vuMeanSquare) * vuCoefficient;
+    
+    if( stepPeak >= heldPeak )
+    {
+        heldPeak = stepPeak;
+        numStepsHeld = 0;
+    }
+    else if( ++numStepsHeld > peakHoldSteps )
+    {
+        heldPeak = juce::jmax(stepPeak, heldPeak * fallFactor);
+    }
+    
+    //keep denormals out once the input goes quiet
+    auto flush = [](float v) { return v < 1.0e-15f ? 0.f : v; };
+    
+    ppm = flush(ppm);
+    vuMeanSquare = flush(vuMeanSquare);
+    heldPeak = flush(heldPeak);
+    
+    reading.ppmDb = juce::Decibels::gainToDecibels(ppm);
+    reading.vuDb = 10.f * std::log10(juce::jmax(vuMeanSquare, 1.0e-10f));
+    reading.peakHoldDb = juce::Decibels::gainToDecibels(heldPeak);
+    reading.numClips += numStepClips;
+    
+    stepPeak = stepEnergy = 0.f;
+    numStepClips = numSamplesInStep = 0;
+}
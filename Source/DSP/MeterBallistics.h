@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    MeterBallistics.h
+    Created: 19 Oct 2026 11:31:52pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ What a meter shows, in dB, apart from the clip count.
+ */
+struct MeterBallisticsReading
+{
+    float ppmDb = -100.f;
+    float vuDb = -100.f;
+    float peakHoldDb = -100.f;
+    
+    //samples at or over full scale since the last resetClips()
+    int numClips = 0;
+};
+
+/*
+ PPM and VU style meter ballistics, with a peak hold and a clip counter.
+ 
+ The signal is fed in sample by sample (or a block at a time), but all it costs per sample
+ is a max, a multiply-add and a compare: samples are gathered into steps of samplesPerStep,
+ and the ballistics only move once per step, on that step's peak and mean square.
+ The steps run on across the host's blocks, so the readings don't depend on the block size.
+ 
+ - PPM: IEC 60268-10 type I style, 5ms integration, falling 20dB in 1.7s
+ - VU: the RMS level, integrated over 300ms
+ - peak hold: the highest sample peak, held for 2s, then falling like the PPM
+ 
+ Audio thread only, the processor publishes the readings with the rest of the meter telemetry.
+ */
+struct MeterBallistics
+{
+    static constexpr int samplesPerStep = 32;
+    
+    void prepare(double sampleRate);
+    void reset();
+    void resetClips() { reading.numClips = 0; }
+    
+    //'magnitude' is the louder channel's absolute value
+    void addSample(float magnitude)
+    {
+        stepPeak = juce::jmax(stepPeak, magnitude);
+        stepEnergy += magnitude * magnitude;
+        numStepClips += magnitude >= 1.f ? 1 : 0;
+        
+        if( ++numSamplesInStep == samplesPerStep )
+            advance();
+    }
+    
+    //for blocks that aren't already being walked through sample by sample
+    void addBlock(const juce::AudioBuffer<float>& buffer);
+    
+    const MeterBallisticsReading& getReading() const { return reading; }
+private:
+    static constexpr float ppmIntegrationSeconds = 0.005f;
+    static constexpr float ppmFallDbPerSecond = 20.f / 1.7f;
+    static constexpr float vuIntegrationSeconds = 0.3f;
+    static constexpr float peakHoldSeconds = 2.f;
+    
+    //per step, worked out in prepare()
+    float ppmAttack = 1.f, fallFactor = 0.f, vuCoefficient = 1.f;
+    int peakHoldSteps = 0;
+    
+    //the step being gathered
+    float stepPeak = 0.f, stepEnergy = 0.f;
+    int numStepClips = 0;
+    int numSamplesInStep = 0;
+    
+    //the ballistics, linear (the VU as a mean square)
+    float ppm = 0.f, vuMeanSquare = 0.f, heldPeak = 0.f;
+    int numStepsHeld = 0;
+    
+    MeterBallisticsReading reading;
+    
+    void advance();
+};
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    MeterTelemetry.h
+    Created: 19 Oct 2026 11:02:36pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cstring>
+#include "MeterBallistics.h"
+
+/*
+ What one band measured. All levels are in dB.
+ The RMS, peak, gain reduction and detector levels cover the last block only,
+ the ballistics run on across blocks.
+ */
+struct BandMeterReading
+{
+    float rmsInputDb = -100.f;
+    float rmsOutputDb = -100.f;
+    float peakInputDb = -100.f;
+    float peakOutputDb = -100.f;
+    
+    //the most gain reduction applied to any sample of the block, 0 or below
+    float gainReductionDb = 0.f;
+    
+    //the loudest the compressor's detector got during the block,
+    //worked out from the gain reduction, see CompressorBand::computeDetectorLevelDb()
+    float detectorLevelDb = -100.f;
+    
+    //how long the band took to process the block
+    float processingMicroseconds = 0.f;
+    
+    MeterBallisticsReading inputBallistics, outputBallistics;
+};
+
+/*
+ Everything the audio thread measured over its last block, published as one piece.
+ Plain data, so it can be copied word by word through a SeqLock.
+ */
+struct MeterSnapshot
+{
+    std::array<BandMeterReading, 3> bands;
+    
+    //the plugin's output, after the output gain
+    MeterBallisticsReading outputBallistics;
+    
+    //how long the whole processBlock() took, and that as a fraction of the block's duration
+    float processingMicroseconds = 0.f;
+    float processingLoad = 0.f;
+    
+    int numSamples = 0;
+};
+
+/*
+ A single writer, any number of readers, lock-free handoff of one value.
+ 
+ The writer bumps the sequence to odd, writes, and bumps it back to even.
+ A reader copies the value and keeps it only if the sequence was the same even number
+ before and after, otherwise it was torn by a write and is copied again.
+ Neither side ever waits on a lock or allocates, and readers don't affect the writer at all.
+ 
+ The value is stored as atomic words, so the racing copies are well defined.
+ Every completed write() bumps getVersion(), readers can use that to skip values they've seen.
+ */
+template<typename T>
+struct SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock copies its value word by word");
+    
+    SeqLock()
+    {
+        write(T {});
+    }
+    
+    //the one writing thread
+    void write(const T& value)
+    {
+        std::array<std::uint32_t, numWords> source { };
+        std::memcpy(source.data(), &value, sizeof(T));
+        
+        auto sequence = sequenceNumber.load(std::memory_order_relaxed);
+        sequenceNumber.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        
+        for( size_t i = 0; i < numWords; ++i )
+            words[i].store(source[i], std::memory_order_relaxed);
+        
+        sequenceNumber.store(sequence + 2, std::memory_order_release);
+    }
+    
+    /**
+     Any thread. Copies the newest value into 'value' and returns true,
+     or leaves 'value' alone and returns false if a write kept getting in the way.
+     Writes are short and far apart, so that takes a writer that never stops.
+     */
+    bool read(T& value) const
+    {
+        std::array<std::uint32_t, numWords> copy;
+        
+        for( int attempt = 0; attempt < maxReadAttempts; ++attempt )
+        {
+            auto before = sequenceNumber.load(std::memory_order_acquire);
+            
+            //a write is under way
+            if( before & 1 )
+                continue;
+            
+            for( size_t i = 0; i < numWords; ++i )
+                copy[i] = words[i].load(std::memory_order_relaxed);
+            
+            std::atomic_thread_fence(std::memory_order_acquire);
+            
+            if( sequenceNumber.load(std::memory_order_relaxed) == before )
+            {
+                std::memcpy(&value, copy.data(), sizeof(T));
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    //any thread. The number of completed writes.
+    std::uint32_t getVersion() const { return sequenceNumber.load(std::memory_order_acquire) / 2; }
+private:
+    static constexpr size_t numWords = (sizeof(T) + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t);
+    static constexpr int maxReadAttempts = 64;
+    
+    std::atomic<std::uint32_t> sequenceNumber { 0 };
+    std::array<std::atomic<std::uint32_t>, numWords> words;
+};
@@ -1,11 +1,11 @@
-/*
-  ==============================================================================
-
-    Params.cpp
-    Created: 27 Mar 2024 9:18:20pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#include "Params.h"
+/*
+  ==============================================================================
+
+    Params.cpp
+    Created: 27 Mar 2024 9:18:20pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "Params.h"
@@ -1,98 +1,98 @@
-/*
-  ==============================================================================
-
-    Params.h
-    Created: 27 Mar 2024 9:18:20pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-
-namespace Params
-{
-    //This enum contains all of the paramaters we have in the project,
-    //and we will add more as we add DSP and GUI functionality.
-    enum Names
-    {
-        Low_Mid_Crossover_Freq,
-        Mid_High_Crossover_Freq,
-        
-        Threshold_Low_Band,
-        Threshold_Mid_Band,
-        Threshold_High_Band,
-        
-        Attack_Low_Band,
-        Attack_Mid_Band,
-        Attack_High_Band,
-        
-        Release_Low_Band,
-        Release_Mid_Band,
-        Release_High_Band,
-        
-        Ratio_Low_Band,
-        Ratio_Mid_Band,
-        Ratio_High_Band,
-        
-        Bypassed_Low_Band,
-        Bypassed_Mid_Band,
-        Bypassed_High_Band,
-        
-        Solo_Low_Band,
-        Solo_Mid_Band,
-        Solo_High_Band,
-        
-        Mute_Low_Band,
-        Mute_Mid_Band,
-        Mute_High_Band,
-        
-        Gain_In,
-        Gain_Out,
-    }; //end enum Names
-    
-    //Providing a map will allow us to look things up
-    //and not worry about misspelling and other such errors.
-    inline const std::map<Names, juce::String>& GetParams()
-    {
-        static std::map<Names, juce::String> params =
-        {
-            {Low_Mid_Crossover_Freq, "Low-Mid Crossover Freq"},
-            {Mid_High_Crossover_Freq,"Mid-High Crossover Freq"},
-                        
-            {Threshold_Low_Band, "Threshold Low Band"},
-            {Threshold_Mid_Band, "Threshold Mid Band"},
-            {Threshold_High_Band, "Threshold High Band"},
-            
-            {Attack_Low_Band, "Attack Low Band"},
-            {Attack_Mid_Band, "Attack Mid Band"},
-            {Attack_High_Band, "Attack High Band"},
-            
-            {Release_Low_Band, "Release Low Band"},
-            {Release_Mid_Band, "Release Mid Band"},
-            {Release_High_Band, "Release High Band"},
-            
-            {Ratio_Low_Band, "Ratio Low Band"},
-            {Ratio_Mid_Band, "Ratio Mid Band"},
-            {Ratio_High_Band, "Ratio High Band"},
-            
-            {Bypassed_Low_Band, "Bypassed Low Band"},
-            {Bypassed_Mid_Band, "Bypassed Mid Band"},
-            {Bypassed_High_Band, "Bypassed High Band"},
-            
-            {Solo_Low_Band,  "Solo Low Band"},
-            {Solo_Mid_Band,  "Solo Mid Band"},
-            {Solo_High_Band, "Solo High Band"},
-            
-            {Mute_Low_Band,  "Mute Low Band"},
-            {Mute_Mid_Band,  "Mute Mid Band"},
-            {Mute_High_Band, "Mute High Band"},
-            
-            {Gain_In, "Gain In"},
-            {Gain_Out, "Gain Out"}
-        };
-        
-        return params;
-    }
-}
+/*
+  ==============================================================================
+
+    Params.h
+    Created: 27 Mar 2024 9:18:20pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Params
+{
+    //This enum contains all of the paramaters we have in the project,
+    //and we will add more as we add DSP and GUI functionality.
+    enum Names
+    {
+        Low_Mid_Crossover_Freq,
+        Mid_High_Crossover_Freq,
+        
+        Threshold_Low_Band,
+        Threshold_Mid_Band,
+        Threshold_High_Band,
+        
+        Attack_Low_Band,
+        Attack_Mid_Band,
+        Attack_High_Band,
+        
+        Release_Low_Band,
+        Release_Mid_Band,
+        Release_High_Band,
+        
+        Ratio_Low_Band,
+        Ratio_Mid_Band,
+        Ratio_High_Band,
+        
+        Bypassed_Low_Band,
+        Bypassed_Mid_Band,
+        Bypassed_High_Band,
+        
+        Solo_Low_Band,
+        Solo_Mid_Band,
+        Solo_High_Band,
+        
+        Mute_Low_Band,
+        Mute_Mid_Band,
+        Mute_High_Band,
+        
+        Gain_In,
+        Gain_Out,
+    }; //end enum Names
+    
+    //Providing a map will allow us to look things up
+    //and not worry about misspelling and other such errors.
+    inline const std::map<Names, juce::String>& GetParams()
+    {
+        static std::map<Names, juce::String> params =
+        {
+            {Low_Mid_Crossover_Freq, "Low-Mid Crossover Freq"},
+            {Mid_High_Crossover_Freq,"Mid-High Crossover Freq"},
+                        
+            {Threshold_Low_Band, "Threshold Low Band"},
+            {Threshold_Mid_Band, "Threshold Mid Band"},
+            {Threshold_High_Band, "Threshold High Band"},
+            
+            {Attack_Low_Band, "Attack Low Band"},
+            {Attack_Mid_Band, "Attack Mid Band"},
+            {Attack_High_Band, "Attack High Band"},
+            
+            {Release_Low_Band, "Release Low Band"},
+            {Release_Mid_Band, "Release Mid Band"},
+            {Release_High_Band, "Release High Band"},
+            
+            {Ratio_Low_Band, "Ratio Low Band"},
+            {Ratio_Mid_Band, "Ratio Mid Band"},
+            {Ratio_High_Band, "Ratio High Band"},
+            
+            {Bypassed_Low_Band, "Bypassed Low Band"},
+            {Bypassed_Mid_Band, "Bypassed Mid Band"},
+            {Bypassed_High_Band, "Bypassed High Band"},
+            
+            {Solo_Low_Band,  "Solo Low Band"},
+            {Solo_Mid_Band,  "Solo Mid Band"},
+            {Solo_High_Band, "Solo High Band"},
+            
+            {Mute_Low_Band,  "Mute Low Band"},
+            {Mute_Mid_Band,  "Mute Mid Band"},
+            {Mute_High_Band, "Mute High Band"},
+            
+            {Gain_In, "Gain In"},
+            {Gain_Out, "Gain Out"}
+        };
+        
+        return params;
+    }
+}
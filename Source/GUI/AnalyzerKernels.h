@@ -0,0 +1,316 @@
+/*
+  ==============================================================================
+
+    AnalyzerKernels.h
+    Created: 19 Oct 2026 9:12:40am
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <cstdint>
+#include <cstring>
+#include <complex>
+
+namespace AnalyzerKernels
+{
+/*
+ The kernels in here are written as straight, branchless loops over plain arrays
+ so the compiler can turn them into SIMD code on every target we build for
+ (SSE/AVX on x86, NEON on ARM) without us having to maintain intrinsics.
+ */
+
+//Number of samples processed per inner block.
+//Small enough to stay in registers/L1, large enough for the vectorizer to unroll.
+static constexpr int kernelBlockSize = 16;
+
+/*
+ Fast log2 approximation.
+
+ A float is 2^e * m with m in [1, 2), so log2(x) = e + log2(m).
+ The exponent is read straight from the bits, and log2(m) is approximated with a
+ 5th order polynomial in (m - 1), fitted for minimax error on [1, 2).
+
+ Accuracy: the polynomial is within 1.5e-5 of log2(m). Adding the exponent rounds that
+ to a float, which adds up to half an ulp of the result, so |fastLog2(x) - log2(x)| < 1.6e-5
+ for x from 2^-64 to 2^64 (< 1e-4 dB once scaled to decibels), and < 2.2e-5 over all normal,
+ positive x. Denormals, zero, negatives and NaN/Inf must be filtered out by the caller.
+ Benchmarks/Source/KernelBenchmark.cpp checks these bounds.
+ */
+inline float fastLog2(float x) noexcept
+{
+    std::int32_t bits;
+    std::memcpy(&bits, &x, sizeof(float));
+
+    auto exponent = static_cast<float>(((bits >> 23) & 0xff) - 127);
+
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float m;
+    std::memcpy(&m, &bits, sizeof(float));
+
+    auto u = m - 1.f;
+    auto poly = 0.046377183f;
+    poly = poly * u - 0.196249745f;
+    poly = poly * u + 0.417579088f;
+    poly = poly * u - 0.709657283f;
+    poly = poly * u + 1.44196504f;
+
+    return exponent + poly * u;
+}
+
+/*
+ Converts the magnitudes produced by FFT::performFrequencyOnlyForwardTransform()
+ into decibels, in place, in a single pass:
+
+    - normalises by the number of bins
+    - replaces NaN/Inf with silence
+    - clamps to 'negativeInfinity'
+    - converts to dB with fastLog2()
+
+ This matches juce::Decibels::gainToDecibels(v / numBins, negativeInfinity)
+ (with NaN/Inf mapped to negativeInfinity) to within 1e-4 dB.
+ */
+inline void magnitudesToDecibels(float* data, int numBins, float negativeInfinity) noexcept
+{
+    //20 * log10(x) == 20 * log10(2) * log2(x)
+    constexpr float dbPerLog2 = 6.0205999132796239f;
+
+    const auto normalise = 1.f / static_cast<float>(numBins);
+
+    //The smallest gain that is still above negativeInfinity.
+    //Clamping to this instead of testing for zero keeps the loop branch free,
+    //and also keeps denormals away from fastLog2().
+    const auto minGain = juce::jmax(juce::Decibels::decibelsToGain(negativeInfinity, -1000.f),
+                                    std::numeric_limits<float>::min());
+    const auto maxGain = std::numeric_limits<float>::max();
+
+    auto convert = [=](float v)
+    {
+        v *= normalise;
+
+        //NaN fails every comparison and +Inf fails this one, so both become silence
+        v = (v <= maxGain) ? v : 0.f;
+        v = (v > minGain) ? v : minGain;
+
+        auto db = dbPerLog2 * fastLog2(v);
+        return (db > negativeInfinity) ? db : negativeInfinity;
+    };
+
+    int i = 0;
+    for( ; i + kernelBlockSize <= numBins; i += kernelBlockSize )
+    {
+        for( int j = 0; j < kernelBlockSize; ++j )
+            data[i + j] = convert(data[i + j]);
+    }
+
+    for( ; i < numBins; ++i )
+        data[i] = convert(data[i]);
+}
+
+/*
+ Splits the output of one complex FFT, run on 'first + i * second', back into the
+ magnitude spectra of the two real signals.
+ 
+ Since both inputs are real, their spectra are conjugate symmetric, which gives
+    First[k]  = (Z[k] + conj(Z[N - k])) / 2
+    Second[k] = (Z[k] - conj(Z[N - k])) / 2i
+ and the magnitudes come out on the same scale as performFrequencyOnlyForwardTransform().
+ 'fftSize' must be a power of two.
+ */
+inline void separateStereoMagnitudes(const std::complex<float>* packed,
+                                     int fftSize,
+                                     int numBins,
+                                     float* firstMagnitudes,
+                                     float* secondMagnitudes) noexcept
+{
+    const auto mask = fftSize - 1;
+    
+    for( int k = 0; k < numBins; ++k )
+    {
+        const auto z = packed[k];
+        const auto mirrored = packed[(fftSize - k) & mask];
+        
+        //z + conj(mirrored) and z - conj(mirrored), written out so it stays branch free
+        const auto sumRe = z.real() + mirrored.real();
+        const auto sumIm = z.imag() - mirrored.imag();
+        const auto diffRe = z.real() - mirrored.real();
+        const auto diffIm = z.imag() + mirrored.imag();
+        
+        firstMagnitudes[k] = 0.5f * std::sqrt(sumRe * sumRe + sumIm * sumIm);
+        secondMagnitudes[k] = 0.5f * std::sqrt(diffRe * diffRe + diffIm * diffIm);
+    }
+}
+
+/*
+ Describes which FFT bins land in one pixel column of the analyzer.
+ If 'numBins' is zero the column falls between two bins, and its level is
+ interpolated between 'firstBin' and 'firstBin + 1' using 'fraction'.
+ */
+struct ColumnRange
+{
+    int firstBin = 0;
+    int numBins = 0;
+    float fraction = 0.f;
+};
+
+enum class ColumnReduction
+{
+    peak,
+    mean
+};
+
+/*
+ Reduces 'bins' to one level per pixel column.
+ Dense columns (many bins per pixel, i.e. the high end) are reduced with a
+ vectorized max or mean, sparse columns (the low end) are interpolated.
+ */
+inline void reduceColumns(const float* bins,
+                          const ColumnRange* columns,
+                          int numColumns,
+                          ColumnReduction reduction,
+                          float* levels) noexcept
+{
+    for( int x = 0; x < numColumns; ++x )
+    {
+        const auto& column = columns[x];
+        const auto* first = bins + column.firstBin;
+        
+        if( column.numBins == 0 )
+        {
+            levels[x] = first[0] + column.fraction * (first[1] - first[0]);
+        }
+        else if( reduction == ColumnReduction::peak )
+        {
+            levels[x] = juce::FloatVectorOperations::findMaximum(first, column.numBins);
+        }
+        else
+        {
+            auto sum = 0.f;
+            for( int i = 0; i < column.numBins; ++i )
+                sum += first[i];
+            
+            levels[x] = sum / static_cast<float>(column.numBins);
+        }
+    }
+}
+
+/*
+ One row of a fractional-octave smoothing matrix.
+ Every bin is replaced by the mean of the 'numBins' bins starting at 'firstBin'.
+ */
+struct SmoothingKernel
+{
+    int firstBin = 0;
+    int numBins = 1;
+};
+
+/*
+ Applies the smoothing kernels to 'input'.
+ The kernels are contiguous, so each one is evaluated with two lookups into a running
+ sum instead of a loop over its bins, which keeps this O(numBins) no matter how
+ wide the kernels get at the high end.
+ 'runningSum' is scratch space and must hold numBins + 1 values.
+ */
+inline void applySmoothingKernels(const float* input,
+                                  const SmoothingKernel* kernels,
+                                  int numBins,
+                                  double* runningSum,
+                                  float* output) noexcept
+{
+    runningSum[0] = 0.0;
+    for( int i = 0; i < numBins; ++i )
+        runningSum[i + 1] = runningSum[i] + static_cast<double>(input[i]);
+    
+    for( int i = 0; i < numBins; ++i )
+    {
+        const auto& kernel = kernels[i];
+        auto sum = runningSum[kernel.firstBin + kernel.numBins] - runningSum[kernel.firstBin];
+        output[i] = static_cast<float>(sum / static_cast<double>(kernel.numBins));
+    }
+}
+
+/*
+ One-pole averaging towards 'input': average += coefficient * (input - average)
+ */
+inline void exponentialAverage(const float* input, float* average, int numBins, float coefficient) noexcept
+{
+    for( int i = 0; i < numBins; ++i )
+        average[i] += coefficient * (input[i] - average[i]);
+}
+
+/*
+ Peak hold with decay.
+ A bin that reaches a new peak holds it for 'holdSeconds', then falls at 'decayDb'
+ per call until the input catches up with it again.
+ Written with selects instead of branches so it vectorizes.
+ */
+inline void peakHold(const float* input,
+                     float* peaks,
+                     float* holdRemaining,
+                     int numBins,
+                     float holdSeconds,
+                     float elapsedSeconds,
+                     float decayDb) noexcept
+{
+    for( int i = 0; i < numBins; ++i )
+    {
+        const auto v = input[i];
+        const auto isNewPeak = v >= peaks[i];
+        
+        const auto hold = isNewPeak ? holdSeconds : holdRemaining[i] - elapsedSeconds;
+        const auto decayed = hold > 0.f ? peaks[i] : peaks[i] - decayDb;
+        
+        holdRemaining[i] = hold;
+        peaks[i] = decayed > v ? decayed : v;
+    }
+}
+
+struct StereoProducts
+{
+    double leftRight = 0.0, leftLeft = 0.0, rightRight = 0.0;
+};
+
+/*
+ The three sums of products a correlation needs: sum(L * R), sum(L * L) and sum(R * R).
+ Each sum is split over kernelBlockSize independent lanes, which are only added together
+ at the end. Without that the compiler has to keep the additions in order, and can't vectorize them.
+ */
+inline StereoProducts sumStereoProducts(const float* left, const float* right, int numSamples) noexcept
+{
+    float lr[kernelBlockSize] = { }, ll[kernelBlockSize] = { }, rr[kernelBlockSize] = { };
+    
+    int i = 0;
+    for( ; i + kernelBlockSize <= numSamples; i += kernelBlockSize )
+    {
+        for( int j = 0; j < kernelBlockSize; ++j )
+        {
+            const auto l = left[i + j];
+            const auto r = right[i + j];
+            
+            lr[j] += l * r;
+            ll[j] += l * l;
+            rr[j] += r * r;
+        }
+    }
+    
+    StereoProducts sums;
+    
+    for( int j = 0; j < kernelBlockSize; ++j )
+    {
+        sums.leftRight += lr[j];
+        sums.leftLeft += ll[j];
+        sums.rightRight += rr[j];
+    }
+    
+    for( ; i < numSamples; ++i )
+    {
+        sums.leftRight += left[i] * right[i];
+        sums.leftLeft += left[i] * left[i];
+        sums.rightRight += right[i] * right[i];
+    }
+    
+    return sums;
+}
+} //end namespace AnalyzerKernels
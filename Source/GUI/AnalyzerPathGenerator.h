@@ -1,82 +1,185 @@
-/*
-  ==============================================================================
-
-    AnalyzerPathGenerator.h
-    Created: 29 Mar 2024 7:28:08pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "../Utilities.h"
-
-template<typename PathType>
-struct AnalyzerPathGenerator
-{
-    /*
-     converts 'renderData[]' into a juce::Path
-     */
-    void generatePath(const std::vector<float>& renderData,
-                      juce::Rectangle<float> fftBounds,
-                      int fftSize,
-                      float binWidth,
-                      float negativeInfinity)
-    {
-        auto top = fftBounds.getY();
-        auto bottom = fftBounds.getBottom();
-        auto width = fftBounds.getWidth();
-
-        int numBins = (int)fftSize / 2;
-
-        PathType p;
-        p.preallocateSpace(3 * (int)fftBounds.getWidth());
-
-        auto map = [bottom, top, negativeInfinity](float v)
-        {
-            return juce::jmap(v,
-                              NEGATIVE_INFINITY, MAX_DECIBELS,
-                              bottom,   top);
-        };
-
-        auto y = map(renderData[0]);
-
-//        jassert( !std::isnan(y) && !std::isinf(y) );
-        if( std::isnan(y) || std::isinf(y) )
-            y = bottom;
-        
-        p.startNewSubPath(0, y);
-
-        const int pathResolution = 2; //you can draw line-to's every 'pathResolution' pixels.
-
-        for( int binNum = 1; binNum < numBins; binNum += pathResolution )
-        {
-            y = map(renderData[binNum]);
-
-//            jassert( !std::isnan(y) && !std::isinf(y) );
-
-            if( !std::isnan(y) && !std::isinf(y) )
-            {
-                auto binFreq = binNum * binWidth;
-                auto normalizedBinX = juce::mapFromLog10(binFreq, MIN_FREQUENCY, MAX_FREQUENCY);
-                int binX = std::floor(normalizedBinX * width);
-                p.lineTo(binX, y);
-            }
-        }
-
-        pathFifo.push(p);
-    }
-
-    int getNumPathsAvailable() const
-    {
-        return pathFifo.getNumAvailableForReading();
-    }
-
-    bool getPath(PathType& path)
-    {
-        return pathFifo.pull(path);
-    }
-private:
-    Fifo<PathType> pathFifo;
-};
+/*
+  ==============================================================================
+
+    AnalyzerPathGenerator.h
+    Created: 29 Mar 2024 7:28:08pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utilities.h"
+#include "AnalyzerKernels.h"
+#include "SpectrumLayout.h"
+
+/*
+ The bin -> pixel column table.
+ It only depends on the width and the bin layout, so it is rebuilt when the
+ analyzer is resized or the FFT order/sample rate/analysis mode changes.
+ One map can be shared by every AnalyzerPathGenerator drawing into the same area.
+ */
+struct BinToPixelMap
+{
+    //Rebuilds the table if anything it depends on changed
+    void update(int width, const SpectrumLayout& layout)
+    {
+        if( width == mappedWidth && layout == mappedLayout )
+            return;
+        
+        mappedWidth = width;
+        mappedLayout = layout;
+        
+        columns.clear();
+        
+        if( width <= 0 || ! layout.isValid() )
+            return;
+        
+        columns.resize(width);
+        
+        auto columnToFrequency = [width](float x)
+        {
+            return juce::mapToLog10(x / static_cast<float>(width), MIN_FREQUENCY, MAX_FREQUENCY);
+        };
+        
+        for( int x = 0; x < width; ++x )
+        {
+            columns[x] = mapFrequencyRange(layout,
+                                           columnToFrequency(x),
+                                           columnToFrequency(x + 1));
+        }
+    }
+    
+    /*
+     Finds the bins of 'layout' whose centre frequency lies in [lowFrequency, highFrequency).
+     If there are none, the range is interpolated at its centre instead.
+     */
+    static AnalyzerKernels::ColumnRange mapFrequencyRange(const SpectrumLayout& layout,
+                                                          float lowFrequency,
+                                                          float highFrequency)
+    {
+        AnalyzerKernels::ColumnRange column;
+        
+        //the last usable bin needs a neighbour to interpolate with
+        const auto lastBin = layout.numBins - 1;
+        
+        auto firstBin = static_cast<int>(std::ceil(juce::jmax(-1.f, layout.getBin(lowFrequency))));
+        auto endBin = static_cast<int>(std::ceil(juce::jmax(-1.f, layout.getBin(highFrequency))));
+        
+        firstBin = juce::jlimit(layout.getFirstUsableBin(), lastBin, firstBin);
+        endBin = juce::jlimit(firstBin, layout.numBins, endBin);
+        
+        if( endBin > firstBin )
+        {
+            column.firstBin = firstBin;
+            column.numBins = endBin - firstBin;
+            column.fraction = 0.f;
+        }
+        else
+        {
+            //no bins in here, so interpolate at the (geometric) centre of the range
+            auto binPosition = layout.getBin(std::sqrt(lowFrequency * highFrequency));
+            binPosition = juce::jlimit(0.f, static_cast<float>(lastBin - 1), binPosition);
+            
+            column.firstBin = static_cast<int>(binPosition);
+            column.numBins = 0;
+            column.fraction = binPosition - static_cast<float>(column.firstBin);
+        }
+        
+        return column;
+    }
+    
+    int getNumColumns() const { return static_cast<int>(columns.size()); }
+    int getNumBins() const { return mappedLayout.numBins; }
+    const AnalyzerKernels::ColumnRange* getColumns() const { return columns.data(); }
+private:
+    std::vector<AnalyzerKernels::ColumnRange> columns;
+    int mappedWidth = 0;
+    SpectrumLayout mappedLayout;
+};
+
+template<typename PathType>
+struct AnalyzerPathGenerator
+{
+    /*
+     converts 'renderData[]' into a juce::Path, with exactly one point per pixel column,
+     in absolute coordinates.
+     'binToPixelMap' must have been updated for the current width and bin layout.
+     */
+    void generatePath(const std::vector<float>& renderData,
+                      const BinToPixelMap& binToPixelMap,
+                      juce::Rectangle<float> fftBounds,
+                      float negativeInfinity)
+    {
+        auto top = fftBounds.getY();
+        auto bottom = fftBounds.getBottom();
+        
+        const auto numColumns = binToPixelMap.getNumColumns();
+        
+        if( numColumns == 0 || static_cast<int>(renderData.size()) < binToPixelMap.getNumBins() )
+            return;
+        
+        columnLevels.resize(numColumns);
+        
+        AnalyzerKernels::reduceColumns(renderData.data(),
+                                       binToPixelMap.getColumns(),
+                                       numColumns,
+                                       reduction,
+                                       columnLevels.data());
+        
+        auto map = [bottom, top, negativeInfinity](float v)
+        {
+            return juce::jmap(v,
+                              NEGATIVE_INFINITY, MAX_DECIBELS,
+                              bottom,   top);
+        };
+        
+        //The path is rebuilt inside a recycled FIFO slot. clear() keeps the slot's storage,
+        //so once every slot has been used, no more memory is allocated.
+        //The x offset of the analysis area is baked in, so the paths can be stroked as-is.
+        pathFifo.pushInPlace([this, &map, numColumns, bottom, left = fftBounds.getX()](PathType& p)
+        {
+            p.clear();
+            p.preallocateSpace(3 * numColumns);
+            
+            //the levels are already sanitized by the FFT stage, so no NaN/Inf checks are needed here
+            p.startNewSubPath(left, map(columnLevels[0]));
+            
+            for( int x = 1; x < numColumns; ++x )
+            {
+                p.lineTo(left + x, map(columnLevels[x]));
+            }
+            
+            if( closed )
+            {
+                p.lineTo(left + numColumns - 1, bottom);
+                p.lineTo(left, bottom);
+                p.closeSubPath();
+            }
+        });
+    }
+    
+    void setColumnReduction(AnalyzerKernels::ColumnReduction newReduction) { reduction = newReduction; }
+    
+    //closed paths run back along the bottom of 'fftBounds', so they can be filled
+    void setClosed(bool shouldBeClosed) { closed = shouldBeClosed; }
+
+    int getNumPathsAvailable() const
+    {
+        return pathFifo.getNumAvailableForReading();
+    }
+
+    //swaps the oldest path into 'path', see Fifo::pullAndRecycle()
+    bool getPath(PathType& path)
+    {
+        return pathFifo.pullAndRecycle(path);
+    }
+private:
+    Fifo<PathType> pathFifo;
+    
+    AnalyzerKernels::ColumnReduction reduction = AnalyzerKernels::ColumnReduction::peak;
+    bool closed = false;
+    
+    std::vector<float> columnLevels;
+};
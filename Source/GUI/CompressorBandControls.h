@@ -1,59 +1,98 @@
-/*
-  ==============================================================================
-
-    CompressorBandControls.h
-    Created: 27 Mar 2024 8:30:07pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "RotarySliderWithLabels.h"
-
-struct CompressorBandControls : juce::Component, juce::Button::Listener
-{
-    CompressorBandControls(juce::AudioProcessorValueTreeState& apvts);
-    
-    void resized() override;
-    
-    void paint(juce::Graphics& g) override;
-    
-    void buttonClicked(juce::Button* button) override;
-    
-    void toggleAllBands(bool shouldBeBypassed);
-    
-    ~CompressorBandControls() override;
-    
-    juce::AudioProcessorValueTreeState& apvts;
-    
-private:
-    RotarySliderWithLabels attackSlider, releaseSlider, thresholdSlider /*, ratioSlider*/;
-    RatioSlider ratioSlider;
-    
-    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attackSliderAttachment, releaseSliderAttachment, thresholdSliderAttachment, ratioSliderAttachment;
-    
-    juce::ToggleButton bypassButton, soloButton, muteButton, lowBandButton, midBandButton, highBandButton;
-    
-    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> bypassButtonAttachment, soloButtonAttachment, muteButtonAttachment;
-    
-    juce::Component::SafePointer<CompressorBandControls> safePtr { this };
-    
-    juce::ToggleButton* activeBand = &lowBandButton;
-    
-    void updateActiveBandFillColors(juce::Button& clickedButton);
-    
-    void resetActiveBandFillColors();
-    
-    void refreshBandButtonColors(juce::Button& band, juce::Button& colorSource);
-    
-    void updateBandSelectButtonStates();
-    
-    void updateSliderEnablements();
-    
-    void updateSoloMuteBypassToggleStates(juce::Button& clickedButton);
-    
-    void updateAttachments();
-    
-};
+/*
+  ==============================================================================
+
+    CompressorBandControls.h
+    Created: 27 Mar 2024 8:30:07pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "RotarySliderWithLabels.h"
+#include "../DSP/Params.h"
+
+struct CompressorBandControls : juce::Component, juce::Button::Listener
+{
+    CompressorBandControls(juce::AudioProcessorValueTreeState& apvts);
+    
+    void resized() override;
+    
+    void paint(juce::Graphics& g) override;
+    
+    void buttonClicked(juce::Button* button) override;
+    
+    void toggleAllBands(bool shouldBeBypassed);
+    
+    ~CompressorBandControls() override;
+    
+    juce::AudioProcessorValueTreeState& apvts;
+    
+    static constexpr int numBands = 3;
+    
+private:
+    /*
+     The sliders and buttons for one band, attached to that band's parameters for good.
+     Every band gets its own set up front, and switching bands just shows a different set,
+     so nothing is attached, detached or looked up while the user clicks through the bands.
+     */
+    struct BandControlSet
+    {
+        //the parameters of one band, in the order the controls are declared
+        enum Pos
+        {
+            Attack,
+            Release,
+            Threshold,
+            Ratio,
+            Bypass,
+            Solo,
+            Mute,
+            NumParams
+        };
+        
+        BandControlSet(juce::AudioProcessorValueTreeState& apvts,
+                       const std::array<Params::Names, NumParams>& names);
+        
+        RotarySliderWithLabels attackSlider, releaseSlider, thresholdSlider;
+        RatioSlider ratioSlider;
+        
+        juce::ToggleButton bypassButton, soloButton, muteButton;
+        
+        std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attackSliderAttachment, releaseSliderAttachment, thresholdSliderAttachment, ratioSliderAttachment;
+        
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> bypassButtonAttachment, soloButtonAttachment, muteButtonAttachment;
+        
+        //arrays rather than vectors, so switching bands doesn't allocate
+        std::array<juce::Component*, NumParams> getComponents();
+        std::array<juce::Button*, 3> getButtons() { return { &bypassButton, &soloButton, &muteButton }; }
+    };
+    
+    std::array<std::unique_ptr<BandControlSet>, numBands> bandControlSets;
+    
+    juce::ToggleButton lowBandButton, midBandButton, highBandButton;
+    std::array<juce::ToggleButton*, numBands> bandButtons { &lowBandButton, &midBandButton, &highBandButton };
+    
+    juce::Component::SafePointer<CompressorBandControls> safePtr { this };
+    
+    //the band whose controls are showing
+    int activeBand = 0;
+    
+    int getBandOf(const juce::Button& bandControl) const;
+    
+    void updateBandFillColors(int band, juce::Button& clickedButton);
+    
+    void resetBandFillColors(juce::Button& band);
+    
+    void refreshBandButtonColors(juce::Button& band, juce::Button& colorSource);
+    
+    void updateBandSelectButtonStates();
+    
+    void updateSliderEnablements(BandControlSet& controls);
+    
+    void updateSoloMuteBypassToggleStates(BandControlSet& controls, juce::Button& clickedButton);
+    
+    void showSelectedBand();
+    
+};
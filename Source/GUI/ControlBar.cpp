@@ -1,29 +1,53 @@
-/*
-  ==============================================================================
-
-    ControlBar.cpp
-    Created: 5 Apr 2024 9:09:22am
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#include "ControlBar.h"
-
-
-ControlBar::ControlBar()
-{
-    analyzerButton.setToggleState(true, juce::dontSendNotification);
-    addAndMakeVisible(analyzerButton);
-    
-    addAndMakeVisible(globalBypassButton);
-}
-
-void ControlBar::resized()
-{
-    auto bounds = getLocalBounds();
-    
-    analyzerButton.setBounds(bounds.removeFromLeft(100).withTrimmedTop(4).withTrimmedBottom(4).withTrimmedLeft(8));
-    
-    globalBypassButton.setBounds(bounds.removeFromRight(50).withTrimmedTop(4).withTrimmedBottom(4))
-    ;}
+/*
+  ==============================================================================
+
+    ControlBar.cpp
+    Created: 5 Apr 2024 9:09:22am
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "ControlBar.h"
+#include "FFTOrder.h"
+
+
+ControlBar::ControlBar()
+{
+    analyzerButton.setToggleState(true, juce::dontSendNotification);
+    addAndMakeVisible(analyzerButton);
+    
+    fftOrderSelector.addItem("Auto", FFTOrderSelectorIds::AutoFFTOrder);
+    fftOrderSelector.addItem("2048", FFTOrder::order2048);
+    fftOrderSelector.addItem("4096", FFTOrder::order4096);
+    fftOrderSelector.addItem("8192", FFTOrder::order8192);
+    fftOrderSelector.addItem("Multi-res", FFTOrderSelectorIds::MultiResolutionFFT);
+    fftOrderSelector.setSelectedId(FFTOrderSelectorIds::AutoFFTOrder, juce::dontSendNotification);
+    addAndMakeVisible(fftOrderSelector);
+    
+    displayModeSelector.addItem("Spectrum", DisplayModeSelectorIds::SpectrumDisplay);
+    displayModeSelector.addItem("Spectrogram", DisplayModeSelectorIds::SpectrogramDisplay);
+    displayModeSelector.addItem("Bands", DisplayModeSelectorIds::BandDisplay);
+    displayModeSelector.setSelectedId(DisplayModeSelectorIds::SpectrumDisplay, juce::dontSendNotification);
+    addAndMakeVisible(displayModeSelector);
+    
+    addAndMakeVisible(loudnessDisplay);
+    
+    addAndMakeVisible(globalBypassButton);
+}
+
+void ControlBar::resized()
+{
+    auto bounds = getLocalBounds();
+    
+    analyzerButton.setBounds(bounds.removeFromLeft(100).withTrimmedTop(4).withTrimmedBottom(4).withTrimmedLeft(8));
+    
+    fftOrderSelector.setBounds(bounds.removeFromLeft(100).withTrimmedTop(8).withTrimmedBottom(8).withTrimmedLeft(8));
+    
+    displayModeSelector.setBounds(bounds.removeFromLeft(120).withTrimmedTop(8).withTrimmedBottom(8).withTrimmedLeft(8));
+    
+    globalBypassButton.setBounds(bounds.removeFromRight(50).withTrimmedTop(4).withTrimmedBottom(4))
+    ;
+    
+    loudnessDisplay.setBounds(bounds.removeFromRight(340).withTrimmedTop(8).withTrimmedBottom(8).withTrimmedRight(8));
+}
@@ -1,23 +1,44 @@
-/*
-  ==============================================================================
-
-    ControlBar.h
-    Created: 5 Apr 2024 9:09:22am
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "CustomButtons.h"
-
-struct ControlBar : juce::Component
-{
-    ControlBar();
-    void resized() override;
-    
-    AnalyzerButton analyzerButton;
-    
-    PowerButton globalBypassButton;
-};
+/*
+  ==============================================================================
+
+    ControlBar.h
+    Created: 5 Apr 2024 9:09:22am
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "CustomButtons.h"
+#include "LoudnessDisplay.h"
+
+struct ControlBar : juce::Component
+{
+    ControlBar();
+    void resized() override;
+    
+    AnalyzerButton analyzerButton;
+    
+    //Item ids for the analyzer resolution selector.
+    //The FFT sizes use the FFTOrder as their id, so the selected id can be cast straight back.
+    enum FFTOrderSelectorIds
+    {
+        AutoFFTOrder = 1,
+        MultiResolutionFFT
+    };
+    juce::ComboBox fftOrderSelector;
+    
+    //Item ids for the analyzer display selector
+    enum DisplayModeSelectorIds
+    {
+        SpectrumDisplay = 1,
+        SpectrogramDisplay,
+        BandDisplay
+    };
+    juce::ComboBox displayModeSelector;
+    
+    LoudnessDisplay loudnessDisplay;
+    
+    PowerButton globalBypassButton;
+};
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    CrossoverResponses.h
+    Created: 19 Oct 2026 8:27:15pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SpectrumLayout.h"
+
+/*
+ The magnitude responses of the processor's band split, in dB, at every bin of a SpectrumLayout.
+ 
+ The bands are made with 4th order Linkwitz-Riley filters:
+    low  = LP(low/mid)                        (its allpass doesn't change the magnitude)
+    mid  = HP(low/mid) * LP(mid/high)
+    high = HP(low/mid) * HP(mid/high)
+ 
+ Adding a band's response to a spectrum in dB gives the spectrum of that band,
+ so the analyzer can show the bands from the FFT it already runs, instead of one more FFT per band.
+ */
+struct CrossoverResponses
+{
+    static constexpr int numBands = 3;
+    
+    /**
+     Recomputes the responses if the layout or either crossover changed since the last call.
+     Returns true if they were recomputed.
+     */
+    bool update(const SpectrumLayout& layout, float lowMidFrequency, float midHighFrequency)
+    {
+        if( layout == builtLayout && lowMidFrequency == builtLowMid && midHighFrequency == builtMidHigh )
+            return false;
+        
+        builtLayout = layout;
+        builtLowMid = lowMidFrequency;
+        builtMidHigh = midHighFrequency;
+        
+        for( auto& response : responses )
+            response.resize(static_cast<size_t>(layout.numBins));
+        
+        for( int bin = 0; bin < layout.numBins; ++bin )
+        {
+            auto gains = getBandGainsDb(layout.getFrequency(static_cast<float>(bin)), lowMidFrequency, midHighFrequency);
+            
+            for( int band = 0; band < numBands; ++band )
+                responses[band][bin] = gains[band];
+        }
+        
+        return true;
+    }
+    
+    //the gain of each band at 'frequency', in dB
+    static std::array<float, numBands> getBandGainsDb(float frequency, float lowMidFrequency, float midHighFrequency)
+    {
+        //an LR4 low pass is a Butterworth squared, so |H| = 1 / (1 + (f/fc)^4), and the high pass is 1 - that
+        auto lowPassGain = [frequency](float crossover)
+        {
+            auto ratio = frequency / crossover;
+            return 1.f / (1.f + ratio * ratio * ratio * ratio);
+        };
+        
+        auto toDb = [](float gain) { return juce::Decibels::gainToDecibels(gain, minimumDb); };
+        
+        auto lowMidLowPass = lowPassGain(lowMidFrequency);
+        auto midHighLowPass = lowPassGain(midHighFrequency);
+        
+        return
+        {
+            toDb(lowMidLowPass),
+            toDb((1.f - lowMidLowPass) * midHighLowPass),
+            toDb((1.f - lowMidLowPass) * (1.f - midHighLowPass))
+        };
+    }
+    
+    /**
+     Writes 'spectrum' (in dB) as heard through 'band' into 'bandSpectrum', no lower than 'negativeInfinity'.
+     'bandSpectrum' is only resized if it has to be.
+     */
+    void apply(int band, const std::vector<float>& spectrum, std::vector<float>& bandSpectrum, float negativeInfinity) const
+    {
+        const auto& response = responses[band];
+        const auto numBins = static_cast<int>(juce::jmin(spectrum.size(), response.size()));
+        
+        bandSpectrum.resize(static_cast<size_t>(numBins));
+        
+        juce::FloatVectorOperations::add(bandSpectrum.data(), spectrum.data(), response.data(), numBins);
+        juce::FloatVectorOperations::max(bandSpectrum.data(), bandSpectrum.data(), negativeInfinity, numBins);
+    }
+private:
+    //the deepest a response goes, well below anything the analyzer draws
+    static constexpr float minimumDb = -200.f;
+    
+    std::array<std::vector<float>, numBands> responses;
+    
+    SpectrumLayout builtLayout;
+    float builtLowMid = 0.f, builtMidHigh = 0.f;
+};
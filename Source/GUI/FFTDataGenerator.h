@@ -1,91 +1,259 @@
-/*
-  ==============================================================================
-
-    FFTDataGenerator.h
-    Created: 29 Mar 2024 7:28:55pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "FFTOrder.h"
-
-template<typename BlockType>
-struct FFTDataGenerator
-{
-    /**
-     produces the FFT data from an audio buffer.
-     */
-    void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
-    {
-        const auto fftSize = getFFTSize();
-        
-        fftData.assign(fftData.size(), 0);
-        auto* readIndex = audioData.getReadPointer(0);
-        std::copy(readIndex, readIndex + fftSize, fftData.begin());
-        
-        // first apply a windowing function to our data
-        window->multiplyWithWindowingTable (fftData.data(), fftSize);       // [1]
-        
-        // then render our FFT data..
-        forwardFFT->performFrequencyOnlyForwardTransform (fftData.data());  // [2]
-        
-        int numBins = (int)fftSize / 2;
-        
-        //normalize the fft values.
-        for( int i = 0; i < numBins; ++i )
-        {
-            auto v = fftData[i];
-//            fftData[i] /= (float) numBins;
-            if( !std::isinf(v) && !std::isnan(v) )
-            {
-                v /= float(numBins);
-            }
-            else
-            {
-                v = 0.f;
-            }
-            fftData[i] = v;
-        }
-        
-        //convert them to decibels
-        for( int i = 0; i < numBins; ++i )
-        {
-            fftData[i] = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
-        }
-        
-        fftDataFifo.push(fftData);
-    }
-    
-    void changeOrder(FFTOrder newOrder)
-    {
-        //when you change order, recreate the window, forwardFFT, fifo, fftData
-        //also reset the fifoIndex
-        //things that need recreating should be created on the heap via std::make_unique<>
-        
-        order = newOrder;
-        auto fftSize = getFFTSize();
-        
-        forwardFFT = std::make_unique<juce::dsp::FFT>(order);
-        window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
-        
-        fftData.clear();
-        fftData.resize(fftSize * 2, 0);
-
-        fftDataFifo.prepare(fftData.size());
-    }
-    //==============================================================================
-    int getFFTSize() const { return 1 << order; }
-    int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
-    //==============================================================================
-    bool getFFTData(BlockType& fftData) { return fftDataFifo.pull(fftData); }
-private:
-    FFTOrder order;
-    BlockType fftData;
-    std::unique_ptr<juce::dsp::FFT> forwardFFT;
-    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
-    
-    Fifo<BlockType> fftDataFifo;
-};
+/*
+  ==============================================================================
+
+    FFTDataGenerator.h
+    Created: 29 Mar 2024 7:28:55pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "FFTOrder.h"
+#include "AnalyzerKernels.h"
+#include "../SharedResourceCache.h"
+
+/*
+ The read-only half of an FFT setup: the FFT itself and its window.
+ Neither is written to while rendering, so one plan can be shared by every
+ FFTDataGenerator running at the same order, on any thread.
+ */
+struct FFTPlan
+{
+    explicit FFTPlan(FFTOrder newOrder) :
+    order(newOrder),
+    fft(newOrder),
+    window(static_cast<size_t>(getFFTSize()))
+    {
+        //normalised, to match what juce::dsp::WindowingFunction's constructor does
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(),
+                                                                 window.size(),
+                                                                 juce::dsp::WindowingFunction<float>::blackmanHarris,
+                                                                 true);
+    }
+    
+    int getFFTSize() const { return 1 << order; }
+    
+    /**
+     The plan for 'order', shared by every analyzer in the process.
+     It is built the first time it is asked for and kept from then on, so any number of open editors
+     only ever hold one plan per order, and closing and reopening an editor doesn't build it again.
+     There are only a handful of orders, so keeping them all costs little.
+     Safe to call from any thread, but the first call for each order takes a while.
+     */
+    static std::shared_ptr<const FFTPlan> getShared(FFTOrder order)
+    {
+        static SharedResourceCache<int, FFTPlan> plans { SharedResourceCache<int, FFTPlan>::Lifetime::pinned };
+        
+        return plans.get(static_cast<int>(order), [order]() { return std::make_shared<const FFTPlan>(order); });
+    }
+    
+    const FFTOrder order;
+    const juce::dsp::FFT fft;
+    std::vector<float> window;
+};
+
+template<typename BlockType>
+struct FFTDataGenerator
+{
+    //The generator always analyses a stereo pair, indexed by Channel
+    static constexpr int numChannels = 2;
+    
+    /*
+     Everything that depends on the FFT order lives in here,
+     so a new order can be built on a background thread and swapped in as a whole.
+     */
+    struct Engine
+    {
+        //the FFT and the window, possibly shared with other generators
+        std::shared_ptr<const FFTPlan> plan;
+        
+        BlockType fftData;
+        std::array<Fifo<BlockType>, numChannels> fftDataFifos;
+        
+        //scratch for the stereo packed transform
+        std::vector<juce::dsp::Complex<float>> packedInput, packedOutput;
+        
+        //the sliding window of samples the FFT is run on, one channel per Channel
+        juce::AudioBuffer<float> inputBuffer;
+        
+        int getFFTSize() const { return plan->getFFTSize(); }
+    };
+    
+    ~FFTDataGenerator()
+    {
+        delete pendingEngine.exchange(nullptr);
+    }
+    
+    /**
+     produces the FFT data from an audio buffer, one real FFT per channel.
+     */
+    void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
+    {
+        const auto fftSize = getFFTSize();
+        auto& fftData = engine->fftData;
+        
+        int numBins = (int)fftSize / 2;
+        
+        for( int channel = 0; channel < numChannels; ++channel )
+        {
+            //only the upper half needs clearing, the lower half is overwritten by the copy below
+            juce::FloatVectorOperations::clear(fftData.data() + fftSize, fftSize);
+            auto* readIndex = audioData.getReadPointer(channel);
+            
+            // first apply a windowing function to our data
+            juce::FloatVectorOperations::multiply(fftData.data(), readIndex, engine->plan->window.data(), fftSize);   // [1]
+            
+            // then render our FFT data..
+            engine->plan->fft.performFrequencyOnlyForwardTransform (fftData.data());                                // [2]
+            
+            //normalize the fft values, sanitize NaN/Inf and convert them to decibels in one pass
+            AnalyzerKernels::magnitudesToDecibels(fftData.data(), numBins, negativeInfinity);
+            
+            pushFFTData(channel, fftData.data(), numBins);
+        }
+    }
+    
+    /**
+     produces the FFT data for both channels of an audio buffer with a single complex FFT.
+     
+     Channel 0 goes in the real part and channel 1 in the imaginary part.
+     The two spectra are pulled apart again with the conjugate symmetry of real signals,
+     so this costs one FFT and one windowing pass instead of two of each.
+     */
+    void produceStereoFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
+    {
+        const auto fftSize = getFFTSize();
+        auto& packedInput = engine->packedInput;
+        auto& packedOutput = engine->packedOutput;
+        const auto* window = engine->plan->window.data();
+        
+        int numBins = (int)fftSize / 2;
+        
+        auto* real = audioData.getReadPointer(0);
+        auto* imag = audioData.getReadPointer(1);
+        
+        // first apply the window to both channels while packing them
+        for( int i = 0; i < fftSize; ++i )
+        {
+            packedInput[i] = { real[i] * window[i], imag[i] * window[i] };
+        }
+        
+        // then render our FFT data..
+        engine->plan->fft.perform(packedInput.data(), packedOutput.data(), false);
+        
+        // ..and separate it back into two magnitude spectra, using fftData as scratch
+        auto* firstMagnitudes = engine->fftData.data();
+        auto* secondMagnitudes = firstMagnitudes + fftSize;
+        
+        AnalyzerKernels::separateStereoMagnitudes(packedOutput.data(), fftSize, numBins, firstMagnitudes, secondMagnitudes);
+        
+        AnalyzerKernels::magnitudesToDecibels(firstMagnitudes, numBins, negativeInfinity);
+        AnalyzerKernels::magnitudesToDecibels(secondMagnitudes, numBins, negativeInfinity);
+        
+        pushFFTData(0, firstMagnitudes, numBins);
+        pushFFTData(1, secondMagnitudes, numBins);
+    }
+    
+    /**
+     Allocates the per-generator buffers needed to run with 'plan'.
+     This is safe to call from any thread.
+     */
+    static std::unique_ptr<Engine> createEngine(std::shared_ptr<const FFTPlan> plan)
+    {
+        auto newEngine = std::make_unique<Engine>();
+        
+        newEngine->plan = std::move(plan);
+        auto fftSize = newEngine->getFFTSize();
+        
+        newEngine->fftData.resize(fftSize * 2, 0);
+        for( auto& fifo : newEngine->fftDataFifos )
+            fifo.prepare(fftSize / 2);
+        
+        newEngine->packedInput.resize(fftSize);
+        newEngine->packedOutput.resize(fftSize);
+        
+        newEngine->inputBuffer.setSize(numChannels, fftSize);
+        newEngine->inputBuffer.clear();
+        
+        return newEngine;
+    }
+    
+    /**
+     Rebuilds everything immediately, on the calling thread.
+     Only use this when nothing is rendering yet (i.e. in a constructor),
+     otherwise use postEngine().
+     */
+    void changePlan(std::shared_ptr<const FFTPlan> plan)
+    {
+        engine = createEngine(std::move(plan));
+    }
+    
+    /**
+     Hands over an engine built with createEngine() on another thread.
+     It replaces the current one the next time applyPendingEngine() is called.
+     If an earlier engine is still waiting, it is thrown away.
+     */
+    void postEngine(std::unique_ptr<Engine> newEngine)
+    {
+        delete pendingEngine.exchange(newEngine.release());
+    }
+    
+    /**
+     Swaps in a posted engine, if there is one.
+     Must be called from the thread that renders, before it pulls any audio.
+     The tail of the old input buffer is carried over so the first frame at the
+     new order is a full window of real audio instead of a half-empty one.
+     */
+    bool applyPendingEngine()
+    {
+        std::unique_ptr<Engine> newEngine(pendingEngine.exchange(nullptr));
+        
+        if( newEngine == nullptr )
+            return false;
+        
+        if( engine != nullptr )
+        {
+            auto& oldInput = engine->inputBuffer;
+            auto& newInput = newEngine->inputBuffer;
+            
+            auto numToCopy = juce::jmin(oldInput.getNumSamples(), newInput.getNumSamples());
+            
+            for( int channel = 0; channel < numChannels; ++channel )
+            {
+                newInput.copyFrom(channel,
+                                  newInput.getNumSamples() - numToCopy,
+                                  oldInput,
+                                  channel,
+                                  oldInput.getNumSamples() - numToCopy,
+                                  numToCopy);
+            }
+        }
+        
+        engine = std::move(newEngine);
+        return true;
+    }
+    //==============================================================================
+    //false until the first engine has been applied
+    bool hasEngine() const { return engine != nullptr; }
+    FFTOrder getOrder() const { return engine->plan->order; }
+    int getFFTSize() const { return engine->getFFTSize(); }
+    int getNumAvailableFFTDataBlocks(int channel) const { return engine->fftDataFifos[channel].getNumAvailableForReading(); }
+    juce::AudioBuffer<float>& getInputBuffer() { return engine->inputBuffer; }
+    //==============================================================================
+    //swaps the oldest block into 'fftData', see Fifo::pullAndRecycle()
+    bool getFFTData(int channel, BlockType& fftData) { return engine->fftDataFifos[channel].pullAndRecycle(fftData); }
+private:
+    std::unique_ptr<Engine> engine;
+    std::atomic<Engine*> pendingEngine { nullptr };
+    
+    void pushFFTData(int channel, const float* data, int numBins)
+    {
+        //only the bins are handed on, written straight into a recycled FIFO slot
+        engine->fftDataFifos[channel].pushInPlace([data, numBins](BlockType& block)
+        {
+            block.assign(data, data + numBins);
+        });
+    }
+};
@@ -1,19 +1,36 @@
-/*
-  ==============================================================================
-
-    FFTOrder.h
-    Created: 29 Mar 2024 7:28:47pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-
-enum FFTOrder
-{
-    order2048 = 11,
-    order4096 = 12,
-    order8192 = 13
-};
+/*
+  ==============================================================================
+
+    FFTOrder.h
+    Created: 29 Mar 2024 7:28:47pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+enum FFTOrder
+{
+    order2048 = 11,
+    order4096 = 12,
+    order8192 = 13
+};
+
+/*
+ 2048 points at 48kHz gives bins roughly 23Hz wide.
+ Picking the order from the sample rate keeps that bin width (and so the
+ low-frequency resolution) the same at 96kHz and 192kHz.
+ */
+inline FFTOrder getDefaultFFTOrder(double sampleRate)
+{
+    if( sampleRate <= 0.0 )
+        return FFTOrder::order2048;
+    
+    auto octavesAbove48k = juce::roundToInt(std::log2(sampleRate / 48000.0));
+    
+    return static_cast<FFTOrder>(juce::jlimit(static_cast<int>(FFTOrder::order2048),
+                                              static_cast<int>(FFTOrder::order8192),
+                                              FFTOrder::order2048 + octavesAbove48k));
+}
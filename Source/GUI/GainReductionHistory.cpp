@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+    GainReductionHistory.cpp
+    Created: 19 Oct 2026 7:12:26pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "GainReductionHistory.h"
+#include "../Utilities.h"
+
+GainReductionHistory::GainReductionHistory(SimpleMBCompAudioProcessor& p) :
+audioProcessor(p)
+{
+    using namespace juce;
+    
+    //the same green as the analyzer's GR overlay
+    steadyColour = Colours::limegreen.withMultipliedBrightness(0.4f).getPixelARGB();
+    movingColour = Colours::limegreen.getPixelARGB();
+    backgroundColour = Colours::black.getPixelARGB();
+    
+    resetColumn();
+    
+    setOpaque(true);
+}
+
+void GainReductionHistory::paint(juce::Graphics& g)
+{
+    using namespace juce;
+    
+    auto bounds = drawModuleBackground(g, getLocalBounds());
+    
+    history.draw(g, historyArea);
+    
+    //lane separators and names, on top of the history
+    const auto laneHeight = historyArea.getHeight() / numBands;
+    const std::array<const char*, numBands> bandNames { "Low", "Mid", "High" };
+    
+    g.setFont(10);
+    
+    for( int band = 0; band < numBands; ++band )
+    {
+        auto laneTop = historyArea.getY() + band * laneHeight;
+        
+        if( band > 0 )
+        {
+            g.setColour(Colours::dimgrey);
+            g.drawHorizontalLine(laneTop, float(historyArea.getX()), float(historyArea.getRight()));
+        }
+        
+        g.setColour(Colours::lightgrey);
+        g.drawFittedText(bandNames[band],
+                         Rectangle<int>(bounds.getX() + 4, laneTop, 30, laneHeight),
+                         Justification::centredLeft,
+                         1);
+    }
+}
+
+void GainReductionHistory::resized()
+{
+    //same inset as drawModuleBackground(), plus room for the lane names
+    historyArea = getLocalBounds().reduced(3).withTrimmedLeft(32).withTrimmedRight(2).reduced(0, 2);
+    
+    //during a live resize the old history is stretched into the new area instead
+    if( ! liveResize )
+        resizeHistory();
+}
+
+void GainReductionHistory::setLiveResize(bool isLive)
+{
+    liveResize = isLive;
+    
+    if( ! liveResize )
+    {
+        resizeHistory();
+        repaint(historyArea);
+    }
+}
+
+void GainReductionHistory::resizeHistory()
+{
+    //one pixel column per column of history
+    history.setSize(historyArea.getWidth(), historyArea.getHeight());
+    
+    numColumnsWithoutReduction = 0;
+    resetColumn();
+    
+    discardBacklog = true;
+}
+
+void GainReductionHistory::processFrame()
+{
+    std::array<GainReductionTelemetry*, numBands> telemetry
+    {
+        &audioProcessor.lowBandComp.getGainReductionTelemetry(),
+        &audioProcessor.midBandComp.getGainReductionTelemetry(),
+        &audioProcessor.highBandComp.getGainReductionTelemetry()
+    };
+    
+    //A new history starts from now. Whatever piled up while nothing was reading
+    //(i.e. while no editor was open) is old, and would be drawn as if it had just happened.
+    if( discardBacklog )
+    {
+        for( auto* bandTelemetry : telemetry )
+            bandTelemetry->discardRecords();
+        
+        discardBacklog = false;
+    }
+    
+    //The bands process the same blocks, so they write the same number of records.
+    //Only whole sets are read, so the lanes stay aligned.
+    auto numRecords = telemetry[0]->getNumRecordsAvailable();
+    for( auto* bandTelemetry : telemetry )
+        numRecords = juce::jmin(numRecords, bandTelemetry->getNumRecordsAvailable());
+    
+    const auto recordsPerColumn = getRecordsPerColumn();
+    bool needsRepaint = false;
+    
+    while( numRecords > 0 )
+    {
+        auto numToRead = juce::jlimit(0, numRecords, recordsPerColumn - numRecordsInColumn);
+        
+        for( int band = 0; band < numBands; ++band )
+        {
+            auto& bandColumn = column[band];
+            
+            telemetry[band]->readRecords(numToRead, [&bandColumn](const GainReductionRecord& record)
+            {
+                bandColumn.minDb = juce::jmin(bandColumn.minDb, record.minDb);
+                bandColumn.maxDb = juce::jmax(bandColumn.maxDb, record.maxDb);
+            });
+        }
+        
+        numRecords -= numToRead;
+        numRecordsInColumn += numToRead;
+        
+        if( numRecordsInColumn >= recordsPerColumn )
+        {
+            needsRepaint |= writeColumn();
+            resetColumn();
+        }
+    }
+    
+    if( needsRepaint )
+        repaint(historyArea);
+}
+
+int GainReductionHistory::getRecordsPerColumn() const
+{
+    auto recordsPerSecond = audioProcessor.getSampleRate() / GainReductionTelemetry::samplesPerRecord;
+    //the image, not the area: they only differ during a live resize, and the image is what scrolls
+    auto width = juce::jmax(1, history.getWidth());
+    
+    return juce::jmax(1, juce::roundToInt(historySeconds * recordsPerSecond / width));
+}
+
+void GainReductionHistory::resetColumn()
+{
+    //GR is never above 0dB, so this is "nothing recorded yet" for both ends
+    for( auto& bandColumn : column )
+    {
+        bandColumn.minDb = 0.f;
+        bandColumn.maxDb = -std::numeric_limits<float>::infinity();
+    }
+    
+    numRecordsInColumn = 0;
+}
+
+bool GainReductionHistory::writeColumn()
+{
+    const auto height = history.getHeight();
+    const auto laneHeight = height / numBands;
+    
+    //anything under a tenth of a pixel isn't visible
+    const auto threshold = -0.1f * maxReductionDb / juce::jmax(1, laneHeight);
+    
+    bool hasReduction = false;
+    for( const auto& bandColumn : column )
+        hasReduction |= bandColumn.minDb < threshold;
+    
+    numColumnsWithoutReduction = hasReduction ? 0 : numColumnsWithoutReduction + 1;
+    
+    history.addColumn([&](juce::Image::BitmapData& pixels)
+    {
+        for( int y = 0; y < height; ++y )
+        {
+            auto* pixel = reinterpret_cast<juce::PixelRGB*>(pixels.getPixelPointer(0, y));
+            auto band = laneHeight > 0 ? y / laneHeight : numBands;
+            
+            //the leftover rows under the last lane
+            if( band >= numBands )
+            {
+                pixel->set(backgroundColour);
+                continue;
+            }
+            
+            //the reduction at the centre of this row, 0dB at the top of the lane
+            auto rowDb = -maxReductionDb * (float(y - band * laneHeight) + 0.5f) / float(laneHeight);
+            const auto& bandColumn = column[band];
+            
+            if( rowDb > bandColumn.maxDb )
+                pixel->set(steadyColour);
+            else if( rowDb >= bandColumn.minDb )
+                pixel->set(movingColour);
+            else
+                pixel->set(backgroundColour);
+        }
+    });
+    
+    return numColumnsWithoutReduction <= history.getWidth();
+}
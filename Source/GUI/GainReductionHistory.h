@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    GainReductionHistory.h
+    Created: 19 Oct 2026 7:12:26pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "ScrollingImage.h"
+
+/*
+ A scrolling graph of each band's gain reduction over the last few seconds,
+ one lane per band, 0dB at the top of each lane.
+ 
+ It is drawn from the bands' GainReductionTelemetry records, so it shows everything the
+ compressors did, not just what they happened to be doing when the GUI looked.
+ The steady part of the reduction is drawn dim, and the range it moved through bright.
+ */
+struct GainReductionHistory : juce::Component
+{
+    GainReductionHistory(SimpleMBCompAudioProcessor&);
+    
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    
+    /**
+     Called by the editor once per display refresh.
+     Appends whatever the bands recorded since the last call, and repaints if that changed anything.
+     */
+    void processFrame();
+    
+    /**
+     While the editor is being resized, the history keeps its size and is stretched to fit.
+     It is resized (which clears it) once, when the resize is over.
+     */
+    void setLiveResize(bool isLive);
+private:
+    SimpleMBCompAudioProcessor& audioProcessor;
+    
+    static constexpr int numBands = 3;
+    
+    //how far down each lane goes
+    static constexpr float maxReductionDb = 24.f;
+    
+    //how much time the width of the graph covers
+    static constexpr float historySeconds = 10.f;
+    
+    ScrollingImage history;
+    juce::Rectangle<int> historyArea;
+    bool liveResize = false;
+    
+    //the records gathered for the next column, one per band
+    std::array<GainReductionRecord, numBands> column;
+    int numRecordsInColumn = 0;
+    
+    //once the whole graph has scrolled through without any reduction it is blank,
+    //and adding more blank columns doesn't need a repaint
+    int numColumnsWithoutReduction = 0;
+    
+    //set whenever the history is cleared, the next processFrame() skips the records still waiting
+    bool discardBacklog = true;
+    
+    juce::PixelARGB steadyColour, movingColour, backgroundColour;
+    
+    void resizeHistory();
+    int getRecordsPerColumn() const;
+    void resetColumn();
+    bool writeColumn();
+};
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    LevelMeters.cpp
+    Created: 20 Oct 2026 1:12:40am
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "LevelMeters.h"
+#include "../Utilities.h"
+
+LevelMeters::LevelMeters()
+{
+    setOpaque(true);
+    shownReadings.fill(toShownReading(MeterBallisticsReading {}));
+}
+
+void LevelMeters::paint(juce::Graphics& g)
+{
+    using namespace juce;
+    
+    drawModuleBackground(g, getLocalBounds());
+    
+    const std::array<const char*, NumMeters> names { "Low", "Mid", "High", "Out" };
+    
+    g.setFont(10);
+    
+    for( int i = 0; i < NumMeters; ++i )
+    {
+        const auto& shown = shownReadings[i];
+        auto area = meterAreas[i];
+        
+        g.setColour(Colours::lightgrey);
+        g.drawFittedText(names[i], area.removeFromTop(textHeight), Justification::centred, 1);
+        
+        g.setColour(shown.numClips > 0 ? Colours::red : Colours::grey);
+        g.drawFittedText(String(shown.numClips), area.removeFromBottom(textHeight), Justification::centred, 1);
+        
+        auto bar = getBarArea(meterAreas[i]);
+        
+        g.setColour(Colours::darkgrey);
+        g.fillRect(bar);
+        
+        //the PPM, green up to 0dB and red over it
+        auto zeroY = mapLevelToY(0, bar);
+        auto ppmY = mapLevelToY(shown.ppm, bar);
+        
+        g.setColour(Colours::limegreen);
+        g.fillRect(Rectangle<int>::leftTopRightBottom(bar.getX(), jmax(ppmY, zeroY), bar.getRight(), bar.getBottom()));
+        
+        if( ppmY < zeroY )
+        {
+            g.setColour(Colours::red);
+            g.fillRect(Rectangle<int>::leftTopRightBottom(bar.getX(), ppmY, bar.getRight(), zeroY));
+        }
+        
+        g.setColour(Colours::dimgrey);
+        g.drawHorizontalLine(zeroY, float(bar.getX()), float(bar.getRight()));
+        
+        //the peak hold, nothing to show until something was louder than the bottom of the bar
+        if( shown.peakHold > mapDbToShownLevel(minDb) )
+        {
+            g.setColour(shown.peakHold > 0 ? Colours::red : Colours::white);
+            g.fillRect(bar.getX(), mapLevelToY(shown.peakHold, bar), bar.getWidth(), 2);
+        }
+    }
+}
+
+void LevelMeters::resized()
+{
+    //same inset as drawModuleBackground()
+    auto bounds = getLocalBounds().reduced(3).reduced(2);
+    auto meterWidth = bounds.getWidth() / NumMeters;
+    
+    for( auto& area : meterAreas )
+        area = bounds.removeFromLeft(meterWidth);
+}
+
+void LevelMeters::mouseDown(const juce::MouseEvent&)
+{
+    if( onReset )
+        onReset();
+}
+
+void LevelMeters::update(const MeterSnapshot& snapshot)
+{
+    std::array<ShownReading, NumMeters> readings
+    {
+        toShownReading(snapshot.bands[Low].outputBallistics),
+        toShownReading(snapshot.bands[Mid].outputBallistics),
+        toShownReading(snapshot.bands[High].outputBallistics),
+        toShownReading(snapshot.outputBallistics)
+    };
+    
+    for( int i = 0; i < NumMeters; ++i )
+    {
+        if( readings[i] != shownReadings[i] )
+        {
+            shownReadings[i] = readings[i];
+            repaint(meterAreas[i]);
+        }
+    }
+}
+
+int LevelMeters::mapDbToShownLevel(float db)
+{
+    return juce::roundToInt(juce::jlimit(minDb, maxDb, db) * 10.f);
+}
+
+LevelMeters::ShownReading LevelMeters::toShownReading(const MeterBallisticsReading& reading)
+{
+    ShownReading shown;
+    shown.ppm = mapDbToShownLevel(reading.ppmDb);
+    shown.peakHold = mapDbToShownLevel(reading.peakHoldDb);
+    shown.numClips = reading.numClips;
+    return shown;
+}
+
+int LevelMeters::mapLevelToY(int level, juce::Rectangle<int> bar)
+{
+    return juce::roundToInt(juce::jmap(level / 10.f, minDb, maxDb, float(bar.getBottom()), float(bar.getY())));
+}
+
+juce::Rectangle<int> LevelMeters::getBarArea(juce::Rectangle<int> meterArea)
+{
+    return meterArea.withTrimmedTop(textHeight).withTrimmedBottom(textHeight).reduced(4, 2);
+}
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    LevelMeters.h
+    Created: 20 Oct 2026 1:12:40am
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../DSP/MeterTelemetry.h"
+
+/*
+ A PPM bar for each band's output and one for the plugin's output, side by side.
+ Each bar has a line at its peak hold, and the number of clipped samples below it.
+ Clicking anywhere calls onReset, which should restart the clip counts.
+ */
+struct LevelMeters : juce::Component
+{
+    LevelMeters();
+    
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void mouseDown(const juce::MouseEvent&) override;
+    
+    /**
+     Called by the editor with every new meter snapshot.
+     Only repaints the meters whose readings changed.
+     */
+    void update(const MeterSnapshot& snapshot);
+    
+    std::function<void()> onReset;
+private:
+    enum Meter
+    {
+        Low,
+        Mid,
+        High,
+        Output,
+        NumMeters
+    };
+    
+    //the range the bars cover
+    static constexpr float minDb = -60.f;
+    static constexpr float maxDb = 6.f;
+    
+    //room for the name above each bar and the clip count below it
+    static constexpr int textHeight = 12;
+    
+    //what is drawn, the levels in tenths of a dB
+    struct ShownReading
+    {
+        int ppm = 0;
+        int peakHold = 0;
+        int numClips = 0;
+        
+        bool operator==(const ShownReading& other) const
+        {
+            return ppm == other.ppm && peakHold == other.peakHold && numClips == other.numClips;
+        }
+        
+        bool operator!=(const ShownReading& other) const { return ! (*this == other); }
+    };
+    
+    std::array<ShownReading, NumMeters> shownReadings;
+    std::array<juce::Rectangle<int>, NumMeters> meterAreas;
+    
+    //a level in dB, limited to the bars' range, in tenths of a dB
+    static int mapDbToShownLevel(float db);
+    static ShownReading toShownReading(const MeterBallisticsReading& reading);
+    
+    //the bar's top for a level in tenths of a dB
+    static int mapLevelToY(int level, juce::Rectangle<int> bar);
+    
+    static juce::Rectangle<int> getBarArea(juce::Rectangle<int> meterArea);
+};
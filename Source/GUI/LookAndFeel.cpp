@@ -1,156 +1,227 @@
-/*
-  ==============================================================================
-
-    LookAndFeel.cpp
-    Created: 27 Mar 2024 8:25:58pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#include "LookAndFeel.h"
-#include "RotarySliderWithLabels.h"
-#include "CustomButtons.h"
-
-void LookAndFeel::drawRotarySlider(juce::Graphics& g,
-                                   int x,
-                                   int y,
-                                   int width,
-                                   int height,
-                                   float sliderPosProportional,
-                                   float rotaryStartAngle,
-                                   float rotaryEndAngle,
-                                   juce::Slider & slider)
-{
-    using namespace juce;
-    
-    auto bounds = Rectangle<float>(x, y, width, height);
-    
-    auto enabled = slider.isEnabled();
-    
-    //create and fill a circle
-    g.setColour(enabled ? ColorScheme::getModuleBorderColor() : Colours::dimgrey);
-    g.fillEllipse(bounds);
-    
-    //draw a border around the circle
-    //g.setColour(Colours::black);
-    g.setColour(enabled ? ColorScheme::getSliderBorderColor() : Colours::black);
-    g.drawEllipse(bounds, 3.f);
-    
-    if ( auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider))
-    {
-        //create a narrow rectangle to represent the indicator of the rotary dial
-        auto center = bounds.getCentre();
-        
-        Path p;
-        
-        Rectangle<float> r;
-        r.setLeft(center.getX() - 2);
-        r.setRight(center.getX() + 2);
-        r.setTop(bounds.getY());
-        r.setBottom(center.getY() - rswl->getTextHeight() * 2);
-        
-        g.setColour(ColorScheme::getSliderBorderColor());
-        p.addRoundedRectangle(r,2.f);
-        
-        jassert(rotaryStartAngle < rotaryEndAngle);
-        
-        //convert slider's normalized value to an angle in radians
-        auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
-        
-        //rotate the rectangle to the angle we just calculated
-        p.applyTransform(AffineTransform().rotated(sliderAngRad,center.getX(), center.getY()));
-        
-        g.fillPath(p);
-        
-        g.setFont(rswl->getTextHeight());
-        auto text = rswl->getDisplayString();
-        auto strWidth = g.getCurrentFont().getStringWidth(text);
-        
-        r.setSize(strWidth + 4, rswl->getTextHeight() + 2);
-        r.setCentre(bounds.getCentre());
-        
-        //g.setColour(Colours::blanchedalmond);
-        //g.fillRect(r);
-        
-        g.setColour(Colours::black);
-        g.drawFittedText(text, r.toNearestInt(), juce::Justification::centred, 1);
-    }
-}
-
-void LookAndFeel::drawToggleButton(juce::Graphics &g,
-                                   juce::ToggleButton &toggleButton,
-                                   bool shouldDrawButtonAsHighlighted,
-                                   bool shouldDrawButtonAsDown)
-{
-    using namespace juce;
-    
-    if( auto* pb = dynamic_cast<PowerButton*>(&toggleButton))
-    {
-        Path powerButton;
-        
-        auto bounds = toggleButton.getLocalBounds();
-        
-//        g.setColour(ColorScheme::getGlobalBypassButtonFillColor());
-//        g.fillRect(bounds);
-//        g.setColour(Colours::black);
-//        g.drawRect(bounds);
-        
-        auto size = jmin(bounds.getWidth(),bounds.getHeight()) - 6; //JUCE_LIVE_CONSTANT(6);
-        auto r = bounds.withSizeKeepingCentre(size, size).toFloat();
-        
-        float ang = 24.f; //JUCE_LIVE_CONSTANT(30);
-        
-        size -= 7; //JUCE_LIVE_CONSTANT(6);
-        
-        powerButton.addCentredArc(r.getCentreX(),
-                                  r.getCentreY(),
-                                  size * 0.5,
-                                  size * 0.5,
-                                  0.f,
-                                  degreesToRadians(ang),
-                                  degreesToRadians(360.f - ang),
-                                  true);
-        
-        powerButton.startNewSubPath(r.getCentreX(), r.getY());
-        powerButton.lineTo(r.getCentre());
-        
-        PathStrokeType pst(1.5,PathStrokeType::JointStyle::curved);
-        
-        auto color = toggleButton.getToggleState() ? Colours::dimgrey : ColorScheme::getGlobalBypassButtonBorderColor();
-        
-        g.setColour(color);
-        g.strokePath(powerButton, pst);
-        g.drawEllipse(r,1.5);
-    }
-    else if( auto* analyzerButton = dynamic_cast<AnalyzerButton*>(&toggleButton))
-    {
-        auto color = ! toggleButton.getToggleState() ? Colours::dimgrey : ColorScheme::getGlobalBypassButtonBorderColor();
-        
-        g.setColour(color);
-        
-        auto bounds = toggleButton.getLocalBounds();
-        g.drawRect(bounds);
-        
-        g.strokePath(analyzerButton->randomPath, PathStrokeType(1.f));
-    }
-    else
-    {
-        auto bounds = toggleButton.getLocalBounds().reduced(2);
-        
-        auto buttonIsOn = toggleButton.getToggleState();
-        
-        const int cornerSize = 4;
-        
-        g.setColour(buttonIsOn ?
-                    toggleButton.findColour(TextButton::ColourIds::buttonOnColourId) :
-                    toggleButton.findColour(TextButton::ColourIds::buttonColourId));
-        
-        g.fillRoundedRectangle(bounds.toFloat(), cornerSize); //background
-        
-        g.setColour(buttonIsOn ? juce::Colours::black : juce::Colours::white);
-        g.drawRoundedRectangle(bounds.toFloat(), cornerSize, 1); //border
-        g.drawFittedText(toggleButton.getName(), bounds, juce::Justification::centred, 1); //text
-        
-    }
-}
+/*
+  ==============================================================================
+
+    LookAndFeel.cpp
+    Created: 27 Mar 2024 8:25:58pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "LookAndFeel.h"
+#include "RotarySliderWithLabels.h"
+#include "CustomButtons.h"
+
+void LookAndFeel::drawRotarySlider(juce::Graphics& g,
+                                   int x,
+                                   int y,
+                                   int width,
+                                   int height,
+                                   float sliderPosProportional,
+                                   float rotaryStartAngle,
+                                   float rotaryEndAngle,
+                                   juce::Slider & slider)
+{
+    using namespace juce;
+    
+    auto bounds = Rectangle<float>(x, y, width, height);
+    
+    auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider);
+    auto textHeight = rswl != nullptr ? rswl->getTextHeight() : 0;
+    
+    //the body is rendered at the physical resolution of whatever we're being drawn on, so it stays sharp
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    
+    const auto& knob = getKnob({ width, height, scale, slider.isEnabled(), textHeight });
+    
+    g.drawImage(knob.body, bounds.expanded(knobMargin));
+    
+    if ( rswl != nullptr )
+    {
+        auto center = bounds.getCentre();
+        
+        g.setColour(ColorScheme::getSliderBorderColor());
+        
+        jassert(rotaryStartAngle < rotaryEndAngle);
+        
+        //convert slider's normalized value to an angle in radians
+        auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
+        
+        //the indicator was made at the knob's origin, so size it (if it was made for another size),
+        //move it into place, then rotate it
+        g.fillPath(knob.indicator, AffineTransform::scale(bounds.getWidth() / knob.width, bounds.getHeight() / knob.height)
+                                                  .translated(bounds.getX(), bounds.getY())
+                                                  .rotated(sliderAngRad, center.getX(), center.getY()));
+        
+        g.setFont(textHeight);
+        const auto& displayText = rswl->getDisplayText();
+        
+        Rectangle<float> r;
+        r.setSize(displayText.width + 4, textHeight + 2);
+        r.setCentre(center);
+        
+        g.setColour(Colours::black);
+        g.drawFittedText(displayText.text, r.toNearestInt(), juce::Justification::centred, 1);
+    }
+}
+
+const LookAndFeel::Knob& LookAndFeel::getKnob(const KnobKey& key)
+{
+    using namespace juce;
+    
+    auto existing = knobCache.find(key);
+    if( existing != knobCache.end() )
+        return existing->second;
+    
+    if( numLiveResizes > 0 )
+    {
+        if( auto* nearest = findNearestKnob(key) )
+            return *nearest;
+    }
+    
+    if( knobCache.size() >= maxCachedKnobs )
+        knobCache.clear();
+    
+    Knob knob;
+    knob.width = static_cast<float>(key.width);
+    knob.height = static_cast<float>(key.height);
+    
+    auto bounds = Rectangle<float>(0, 0, key.width, key.height);
+    
+    {
+        auto imageBounds = bounds.expanded(knobMargin);
+        
+        knob.body = Image(Image::ARGB,
+                          jmax(1, roundToInt(imageBounds.getWidth() * key.scale)),
+                          jmax(1, roundToInt(imageBounds.getHeight() * key.scale)),
+                          true);
+        
+        Graphics g(knob.body);
+        g.addTransform(AffineTransform::scale(key.scale));
+        
+        auto circle = bounds.translated(knobMargin, knobMargin);
+        
+        //create and fill a circle
+        g.setColour(key.enabled ? ColorScheme::getModuleBorderColor() : Colours::dimgrey);
+        g.fillEllipse(circle);
+        
+        //draw a border around the circle
+        g.setColour(key.enabled ? ColorScheme::getSliderBorderColor() : Colours::black);
+        g.drawEllipse(circle, 3.f);
+    }
+    
+    //create a narrow rectangle to represent the indicator of the rotary dial, pointing straight up
+    auto center = bounds.getCentre();
+    
+    Rectangle<float> r;
+    r.setLeft(center.getX() - 2);
+    r.setRight(center.getX() + 2);
+    r.setTop(bounds.getY());
+    r.setBottom(center.getY() - key.textHeight * 2);
+    
+    knob.indicator.addRoundedRectangle(r, 2.f);
+    
+    return knobCache.emplace(key, std::move(knob)).first->second;
+}
+
+const LookAndFeel::Knob* LookAndFeel::findNearestKnob(const KnobKey& key) const
+{
+    //only the size may differ, a body for another scale or state would look wrong, not just soft
+    const Knob* nearest = nullptr;
+    int nearestDistance = std::numeric_limits<int>::max();
+    
+    for( const auto& entry : knobCache )
+    {
+        const auto& cachedKey = entry.first;
+        
+        if( cachedKey.scale != key.scale || cachedKey.enabled != key.enabled || cachedKey.textHeight != key.textHeight )
+            continue;
+        
+        auto distance = std::abs(cachedKey.width - key.width) + std::abs(cachedKey.height - key.height);
+        
+        if( distance < nearestDistance )
+        {
+            nearest = &entry.second;
+            nearestDistance = distance;
+        }
+    }
+    
+    return nearest;
+}
+
+void LookAndFeel::drawToggleButton(juce::Graphics &g,
+                                   juce::ToggleButton &toggleButton,
+                                   bool shouldDrawButtonAsHighlighted,
+                                   bool shouldDrawButtonAsDown)
+{
+    using namespace juce;
+    
+    if( auto* pb = dynamic_cast<PowerButton*>(&toggleButton))
+    {
+        Path powerButton;
+        
+        auto bounds = toggleButton.getLocalBounds();
+        
+//        g.setColour(ColorScheme::getGlobalBypassButtonFillColor());
+//        g.fillRect(bounds);
+//        g.setColour(Colours::black);
+//        g.drawRect(bounds);
+        
+        auto size = jmin(bounds.getWidth(),bounds.getHeight()) - 6; //JUCE_LIVE_CONSTANT(6);
+        auto r = bounds.withSizeKeepingCentre(size, size).toFloat();
+        
+        float ang = 24.f; //JUCE_LIVE_CONSTANT(30);
+        
+        size -= 7; //JUCE_LIVE_CONSTANT(6);
+        
+        powerButton.addCentredArc(r.getCentreX(),
+                                  r.getCentreY(),
+                                  size * 0.5,
+                                  size * 0.5,
+                                  0.f,
+                                  degreesToRadians(ang),
+                                  degreesToRadians(360.f - ang),
+                                  true);
+        
+        powerButton.startNewSubPath(r.getCentreX(), r.getY());
+        powerButton.lineTo(r.getCentre());
+        
+        PathStrokeType pst(1.5,PathStrokeType::JointStyle::curved);
+        
+        auto color = toggleButton.getToggleState() ? Colours::dimgrey : ColorScheme::getGlobalBypassButtonBorderColor();
+        
+        g.setColour(color);
+        g.strokePath(powerButton, pst);
+        g.drawEllipse(r,1.5);
+    }
+    else if( auto* analyzerButton = dynamic_cast<AnalyzerButton*>(&toggleButton))
+    {
+        auto color = ! toggleButton.getToggleState() ? Colours::dimgrey : ColorScheme::getGlobalBypassButtonBorderColor();
+        
+        g.setColour(color);
+        
+        auto bounds = toggleButton.getLocalBounds();
+        g.drawRect(bounds);
+        
+        g.strokePath(analyzerButton->randomPath, PathStrokeType(1.f));
+    }
+    else
+    {
+        auto bounds = toggleButton.getLocalBounds().reduced(2);
+        
+        auto buttonIsOn = toggleButton.getToggleState();
+        
+        const int cornerSize = 4;
+        
+        g.setColour(buttonIsOn ?
+                    toggleButton.findColour(TextButton::ColourIds::buttonOnColourId) :
+                    toggleButton.findColour(TextButton::ColourIds::buttonColourId));
+        
+        g.fillRoundedRectangle(bounds.toFloat(), cornerSize); //background
+        
+        g.setColour(buttonIsOn ? juce::Colours::black : juce::Colours::white);
+        g.drawRoundedRectangle(bounds.toFloat(), cornerSize, 1); //border
+        g.drawFittedText(toggleButton.getName(), bounds, juce::Justification::centred, 1); //text
+        
+    }
+}
@@ -1,63 +1,114 @@
-/*
-  ==============================================================================
-
-    LookAndFeel.h
-    Created: 27 Mar 2024 8:25:58pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-
-#define USE_LIVE_CONSTANT false
-
-#if USE_LIVE_CONSTANT
-#define colorHelper(c) JUCE_LIVE_CONSTANT(c);
-#else
-#define colorHelper(c) c;
-#endif
-
-namespace ColorScheme
-{
-inline juce::Colour getSliderBorderColor()
-{
-    return colorHelper( juce::Colour(0xff9c947d) );
-}
-inline juce::Colour getModuleBorderColor()
-{
-    return colorHelper( juce::Colour(0xff307d6e) );
-}
-//inline juce::Colour getGlobalBypassButtonFillColor()
-//{
-//    return colorHelper( juce::Colour(0xff00cbe7) );
-//}
-inline juce::Colour getGlobalBypassButtonBorderColor()
-{
-    return colorHelper( juce::Colour(0xfff450c1))
-}
-
-//Text
-
-inline juce::Colour getLabelTextColor()
-{
-    return colorHelper( juce::Colour(0xff1690c1));
-}
-
-}
-
-struct LookAndFeel : juce::LookAndFeel_V4
-{
-    void drawRotarySlider (juce::Graphics&,
-                           int x, int y, int width, int height,
-                           float sliderPosProportional,
-                           float rotaryStartAngle,
-                           float rotaryEndAngle,
-                           juce::Slider&) override;
-    
-    void drawToggleButton (juce::Graphics &g,
-                           juce::ToggleButton & toggleButton,
-                           bool shouldDrawButtonAsHighlighted,
-                           bool shouldDrawButtonAsDown) override;
-};
+/*
+  ==============================================================================
+
+    LookAndFeel.h
+    Created: 27 Mar 2024 8:25:58pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <map>
+#include <tuple>
+
+#define USE_LIVE_CONSTANT false
+
+#if USE_LIVE_CONSTANT
+#define colorHelper(c) JUCE_LIVE_CONSTANT(c);
+#else
+#define colorHelper(c) c;
+#endif
+
+namespace ColorScheme
+{
+inline juce::Colour getSliderBorderColor()
+{
+    return colorHelper( juce::Colour(0xff9c947d) );
+}
+inline juce::Colour getModuleBorderColor()
+{
+    return colorHelper( juce::Colour(0xff307d6e) );
+}
+//inline juce::Colour getGlobalBypassButtonFillColor()
+//{
+//    return colorHelper( juce::Colour(0xff00cbe7) );
+//}
+inline juce::Colour getGlobalBypassButtonBorderColor()
+{
+    return colorHelper( juce::Colour(0xfff450c1))
+}
+
+//Text
+
+inline juce::Colour getLabelTextColor()
+{
+    return colorHelper( juce::Colour(0xff1690c1));
+}
+
+}
+
+struct LookAndFeel : juce::LookAndFeel_V4
+{
+    void drawRotarySlider (juce::Graphics&,
+                           int x, int y, int width, int height,
+                           float sliderPosProportional,
+                           float rotaryStartAngle,
+                           float rotaryEndAngle,
+                           juce::Slider&) override;
+    
+    void drawToggleButton (juce::Graphics &g,
+                           juce::ToggleButton & toggleButton,
+                           bool shouldDrawButtonAsHighlighted,
+                           bool shouldDrawButtonAsDown) override;
+    
+    /*
+     While an editor is being resized, knobs are drawn from the nearest size already cached,
+     stretched, instead of rendering a new body for every size the drag passes through.
+     Once the drag is over they are rendered at their real size again.
+     Every editor shares this look-and-feel, so it counts how many of them are resizing.
+     */
+    void beginLiveResize() { ++numLiveResizes; }
+    void endLiveResize() { numLiveResizes = juce::jmax(0, numLiveResizes - 1); }
+private:
+    /*
+     The knob body (the filled circle and its border) only depends on its size,
+     the display scale and whether the slider is enabled, so each one is rendered once
+     into an image and blitted after that. The indicator's shape is kept alongside it,
+     un-rotated, so drawing a knob is a blit, a transformed fill and its value text.
+     */
+    struct KnobKey
+    {
+        int width, height;
+        float scale;
+        bool enabled;
+        int textHeight;
+        
+        auto tie() const { return std::tie(width, height, scale, enabled, textHeight); }
+        bool operator<(const KnobKey& other) const { return tie() < other.tie(); }
+    };
+    
+    struct Knob
+    {
+        juce::Image body;
+        juce::Path indicator;
+        
+        //the size it was made for, which is not the size it's drawn at during a live resize
+        float width = 0.f, height = 0.f;
+    };
+    
+    //the border is stroked on the edge of the circle, so half of it falls outside the knob's bounds
+    static constexpr float knobMargin = 2.f;
+    
+    //Every editor shares this look-and-feel, and so this cache.
+    //There are only a handful of knob sizes, this just stops resizing from growing it forever
+    static constexpr size_t maxCachedKnobs = 32;
+    
+    std::map<KnobKey, Knob> knobCache;
+    
+    int numLiveResizes = 0;
+    
+    const Knob& getKnob(const KnobKey& key);
+    const Knob* findNearestKnob(const KnobKey& key) const;
+};
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    LoudnessDisplay.cpp
+    Created: 19 Oct 2026 8:02:47pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "LoudnessDisplay.h"
+
+LoudnessDisplay::LoudnessDisplay()
+{
+    shownValues.fill(silentValue);
+}
+
+void LoudnessDisplay::paint(juce::Graphics& g)
+{
+    using namespace juce;
+    
+    const std::array<const char*, NumReadouts> names { "M", "S", "I", "TP" };
+    
+    auto bounds = getLocalBounds();
+    auto readoutWidth = bounds.getWidth() / NumReadouts;
+    
+    g.setFont(12);
+    
+    for( int i = 0; i < NumReadouts; ++i )
+    {
+        auto area = bounds.removeFromLeft(readoutWidth).reduced(2, 0);
+        
+        g.setColour(Colours::grey);
+        g.drawFittedText(names[i], area.removeFromLeft(18), Justification::centredLeft, 1);
+        
+        auto value = shownValues[i];
+        auto text = value <= silentValue ? String("-inf") : String(value / 10.f, 1);
+        
+        //a true peak over 0dBTP will clip somewhere downstream
+        g.setColour(i == TruePeak && value > 0 ? Colours::red : Colours::lightgrey);
+        g.drawFittedText(text, area, Justification::centredLeft, 1);
+    }
+}
+
+void LoudnessDisplay::mouseDown(const juce::MouseEvent&)
+{
+    if( onReset )
+        onReset();
+}
+
+void LoudnessDisplay::setValues(float momentary, float shortTerm, float integrated, float truePeak)
+{
+    auto toShownValue = [](float value)
+    {
+        //-inf, and anything quiet enough to be meaningless, all look the same
+        return std::isfinite(value) ? juce::jmax(silentValue, juce::roundToInt(value * 10.f)) : silentValue;
+    };
+    
+    std::array<int, NumReadouts> values
+    {
+        toShownValue(momentary),
+        toShownValue(shortTerm),
+        toShownValue(integrated),
+        toShownValue(truePeak)
+    };
+    
+    if( values != shownValues )
+    {
+        shownValues = values;
+        repaint();
+    }
+}
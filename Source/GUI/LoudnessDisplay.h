@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    LoudnessDisplay.h
+    Created: 19 Oct 2026 8:02:47pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ The momentary, short-term and integrated loudness and the true peak, as text.
+ Clicking it calls onReset, which should restart the integrated loudness, the true peak hold and the clip counts.
+ */
+struct LoudnessDisplay : juce::Component
+{
+    LoudnessDisplay();
+    
+    void paint(juce::Graphics& g) override;
+    void mouseDown(const juce::MouseEvent&) override;
+    
+    /**
+     Called once per display refresh.
+     Only repaints when one of the readouts changes at the precision it is shown with.
+     */
+    void setValues(float momentary, float shortTerm, float integrated, float truePeak);
+    
+    std::function<void()> onReset;
+private:
+    enum Readout
+    {
+        Momentary,
+        ShortTerm,
+        Integrated,
+        TruePeak,
+        NumReadouts
+    };
+    
+    //the values in tenths of a dB, which is what is shown
+    std::array<int, NumReadouts> shownValues;
+    
+    //anything at or below this is shown as "-inf"
+    static constexpr int silentValue = -700;
+};
@@ -0,0 +1,424 @@
+/*
+  ==============================================================================
+
+    MultiResolutionAnalyzer.h
+    Created: 19 Oct 2026 5:48:31pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "../Utilities.h"
+#include "AnalyzerKernels.h"
+#include "AnalyzerPathGenerator.h"
+#include "FFTDataGenerator.h"
+#include "SpectrumLayout.h"
+
+/*
+ Lowpasses at a quarter of the sample rate and keeps every other sample.
+ 
+ The filter is a windowed-sinc half-band FIR. Every other tap of a half-band filter
+ is zero (apart from the centre one), and only every other output is kept,
+ so it costs about a quarter of a plain FIR of the same length.
+ Everything below ~0.32 of the output rate comes through clean and alias free.
+ */
+struct HalfBandDecimator
+{
+    HalfBandDecimator() { reset(); }
+    
+    void reset()
+    {
+        history.fill(0.f);
+        writeIndex = 0;
+        keepThisSample = true;
+    }
+    
+    /**
+     Decimates 'numSamples' from 'input' into 'output' and returns how many samples were written.
+     'output' may be the same buffer as 'input'.
+     */
+    int process(const float* input, int numSamples, float* output)
+    {
+        const auto& coefficients = getCoefficients();
+        
+        int numOutputSamples = 0;
+        
+        for( int i = 0; i < numSamples; ++i )
+        {
+            //the history is stored twice, so the newest numTaps samples are always contiguous
+            history[writeIndex] = history[writeIndex + numTaps] = input[i];
+            writeIndex = (writeIndex + 1) % numTaps;
+            
+            auto keep = keepThisSample;
+            keepThisSample = ! keepThisSample;
+            
+            if( ! keep )
+                continue;
+            
+            const auto* x = history.data() + writeIndex;
+            
+            auto sum = coefficients[halfLength] * x[halfLength];
+            for( int tap = 0; tap < numTaps; tap += 2 )
+                sum += coefficients[tap] * x[tap];
+            
+            output[numOutputSamples++] = sum;
+        }
+        
+        return numOutputSamples;
+    }
+private:
+    //taps either side of the centre. Odd, so the non-zero taps are the even ones.
+    static constexpr int halfLength = 15;
+    static constexpr int numTaps = 2 * halfLength + 1;
+    static_assert( halfLength % 2 == 1, "the even taps must be the non-zero ones" );
+    
+    std::array<float, 2 * numTaps> history;
+    int writeIndex = 0;
+    bool keepThisSample = true;
+    
+    static const std::array<float, numTaps>& getCoefficients()
+    {
+        static const auto coefficients = []()
+        {
+            std::array<float, numTaps> c { };
+            double sum = 0.0;
+            
+            for( int n = 0; n < numTaps; ++n )
+            {
+                auto k = n - halfLength;
+                
+                //sinc at a quarter of the sample rate, Blackman windowed
+                auto sinc = k == 0 ? 0.5 : std::sin(juce::MathConstants<double>::halfPi * k) / (juce::MathConstants<double>::pi * k);
+                auto phase = juce::MathConstants<double>::twoPi * n / (numTaps - 1);
+                auto window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+                
+                //the odd taps are exactly zero in theory, make sure they are in practice too
+                c[n] = (k != 0 && k % 2 == 0) ? 0.f : static_cast<float>(sinc * window);
+                sum += c[n];
+            }
+            
+            //unity gain at DC
+            for( auto& v : c )
+                v = static_cast<float>(v / sum);
+            
+            return c;
+        }();
+        
+        return coefficients;
+    }
+};
+
+/*
+ A constant-Q style analyzer built from small FFTs.
+ 
+ The input is split into octave stages by repeatedly decimating by 2 with half-band
+ filters. Each stage runs the same small FFT, so every halving of the sample rate
+ halves the bin width: the lowest stage ends up with much finer bins than even the
+ largest single FFT, while the top stays short and sharp in time.
+ 
+ Each stage only contributes the octave(s) its bins are good for, and the stages are
+ stitched into one spectrum on a logarithmic grid (see SpectrumLayout).
+ The interface matches FFTDataGenerator, so PathProducer can drain either one.
+ 
+ Lower stages use longer windows, so they react more slowly, which is
+ the usual trade-off for the extra resolution.
+ */
+struct MultiResolutionAnalyzer
+{
+    static constexpr int numChannels = 2;
+    
+    //Every stage runs a 512 point FFT
+    static constexpr int fftOrder = 9;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBins = fftSize / 2;
+    
+    //A stage re-runs its FFT after this many new samples (87.5% overlap),
+    //so the low stages, which receive few samples, rarely need to.
+    static constexpr int updateInterval = fftSize / 8;
+    
+    //Resolution of the stitched output
+    static constexpr int binsPerOctave = 48;
+    
+    //The lowest stage runs at no less than this rate, which keeps its window under ~0.9s
+    static constexpr double minimumStageRate = 600.0;
+    static constexpr int maxNumStages = 10;
+    
+    //Every stage uses the same kind of plan as the single FFT analyzer, so the levels match,
+    //and it is shared with every other instance. 512 points is below the orders the
+    //single FFT offers, but it's a plain FFT order all the same.
+    MultiResolutionAnalyzer() :
+    plan(FFTPlan::getShared(static_cast<FFTOrder>(fftOrder))),
+    layout(SpectrumLayout::logarithmic(MIN_FREQUENCY, MAX_FREQUENCY, binsPerOctave))
+    {
+        fftBuffer.resize(fftSize * 2, 0.f);
+        
+        for( auto& fifo : fftDataFifos )
+            fifo.prepare(static_cast<size_t>(layout.numBins));
+    }
+    
+    /**
+     Builds the stages for 'sampleRate'. Does nothing if it hasn't changed.
+     Must be called from the thread that pushes samples.
+     */
+    void prepare(double sampleRate)
+    {
+        if( sampleRate == preparedSampleRate || sampleRate <= 0.0 )
+            return;
+        
+        preparedSampleRate = sampleRate;
+        
+        auto numStages = 1 + static_cast<int>(std::floor(std::log2(sampleRate / minimumStageRate)));
+        numStages = juce::jlimit(1, maxNumStages, numStages);
+        
+        stages.resize(numStages);
+        
+        for( int s = 0; s < numStages; ++s )
+        {
+            auto& stage = stages[s];
+            auto stageRate = sampleRate / std::exp2(s);
+            
+            for( auto& samples : stage.samples )
+                samples.assign(fftSize, 0.f);
+            
+            for( auto& spectrum : stage.spectra )
+                spectrum.assign(numBins, NEGATIVE_INFINITY);
+            
+            //The stage covers the octave below a quarter of its rate, well clear of the
+            //decimation filter's transition band. The top stage isn't decimated, so it
+            //covers everything above that, and the bottom stage everything below.
+            auto lowestFrequency = s == numStages - 1 ? 0.f : static_cast<float>(stageRate / 8.0);
+            auto highestFrequency = s == 0 ? std::numeric_limits<float>::max() : static_cast<float>(stageRate / 4.0);
+            
+            //getBin() is -inf at 0Hz, so clamp before converting
+            auto pointAt = [this](float frequency)
+            {
+                auto point = juce::jlimit(-1.f, static_cast<float>(layout.numBins), layout.getBin(frequency));
+                return static_cast<int>(std::ceil(point));
+            };
+            
+            auto firstPoint = juce::jlimit(0, layout.numBins, pointAt(lowestFrequency));
+            auto endPoint = juce::jlimit(firstPoint, layout.numBins, pointAt(highestFrequency));
+            
+            stage.firstPoint = firstPoint;
+            stage.columns.clear();
+            
+            //each output point takes the bins between it and its neighbours
+            auto stageLayout = SpectrumLayout::linear(numBins, static_cast<float>(stageRate / fftSize));
+            
+            for( int point = firstPoint; point < endPoint; ++point )
+            {
+                stage.columns.push_back(BinToPixelMap::mapFrequencyRange(stageLayout,
+                                                                         layout.getFrequency(point - 0.5f),
+                                                                         layout.getFrequency(point + 0.5f)));
+            }
+        }
+        
+        reset();
+    }
+    
+    //Clears all history, i.e. after not being fed for a while
+    void reset()
+    {
+        for( auto& stage : stages )
+        {
+            for( auto& decimator : stage.decimators )
+                decimator.reset();
+            
+            for( auto& samples : stage.samples )
+                std::fill(samples.begin(), samples.end(), 0.f);
+            
+            for( auto& spectrum : stage.spectra )
+                std::fill(spectrum.begin(), spectrum.end(), NEGATIVE_INFINITY);
+            
+            stage.newSamples = 0;
+        }
+        
+        samplesSinceLastFrame = 0;
+    }
+    
+    /**
+     Feeds one channel's new samples through all stages.
+     Push the same number of samples to both channels before calling produceFFTDataForRendering().
+     */
+    void pushSamples(int channel, const float* data, int numSamples)
+    {
+        //only grows, so this stops allocating after the first few blocks
+        if( static_cast<int>(decimated.size()) < numSamples )
+            decimated.resize(numSamples);
+        
+        const float* input = data;
+        
+        for( size_t s = 0; s < stages.size(); ++s )
+        {
+            auto& stage = stages[s];
+            
+            if( s > 0 )
+            {
+                numSamples = stage.decimators[channel].process(input, numSamples, decimated.data());
+                input = decimated.data();
+            }
+            
+            appendSamples(stage.samples[channel], input, numSamples);
+            
+            if( channel == 0 )
+                stage.newSamples += numSamples;
+            
+            if( channel == 0 && s == 0 )
+                samplesSinceLastFrame += numSamples;
+        }
+    }
+    
+    /**
+     Re-runs the FFT of every stage that has received enough new samples,
+     then stitches one new frame per channel into the FIFOs.
+     With blocks shorter than updateInterval that doesn't happen on every call,
+     so each frame is queued with how much audio it actually covers.
+     */
+    void produceFFTDataForRendering(const float negativeInfinity)
+    {
+        bool anyStageUpdated = false;
+        
+        for( auto& stage : stages )
+        {
+            if( stage.newSamples < updateInterval )
+                continue;
+            
+            stage.newSamples = 0;
+            anyStageUpdated = true;
+            
+            for( int channel = 0; channel < numChannels; ++channel )
+            {
+                juce::FloatVectorOperations::multiply(fftBuffer.data(), stage.samples[channel].data(), plan->window.data(), fftSize);
+                juce::FloatVectorOperations::clear(fftBuffer.data() + fftSize, fftSize);
+                
+                plan->fft.performFrequencyOnlyForwardTransform(fftBuffer.data());
+                
+                AnalyzerKernels::magnitudesToDecibels(fftBuffer.data(), numBins, negativeInfinity);
+                
+                std::copy(fftBuffer.begin(), fftBuffer.begin() + numBins, stage.spectra[channel].begin());
+            }
+        }
+        
+        if( ! anyStageUpdated )
+            return;
+        
+        const auto frameSeconds = static_cast<float>(samplesSinceLastFrame / preparedSampleRate);
+        samplesSinceLastFrame = 0;
+        
+        for( int channel = 0; channel < numChannels; ++channel )
+        {
+            auto pushed = fftDataFifos[channel].pushInPlace([this, channel](std::vector<float>& frame)
+            {
+                frame.resize(static_cast<size_t>(layout.numBins));
+                
+                //points outside every stage (i.e. above Nyquist) stay silent
+                std::fill(frame.begin(), frame.end(), NEGATIVE_INFINITY);
+                
+                for( const auto& stage : stages )
+                {
+                    AnalyzerKernels::reduceColumns(stage.spectra[channel].data(),
+                                                   stage.columns.data(),
+                                                   static_cast<int>(stage.columns.size()),
+                                                   AnalyzerKernels::ColumnReduction::peak,
+                                                   frame.data() + stage.firstPoint);
+                }
+            });
+            
+            if( pushed )
+                frameDurations[channel].push(frameSeconds);
+        }
+    }
+    //==============================================================================
+    const SpectrumLayout& getLayout() const { return layout; }
+    int getNumAvailableFFTDataBlocks(int channel) const { return fftDataFifos[channel].getNumAvailableForReading(); }
+    /**
+     Swaps the oldest frame into 'fftData', see Fifo::pullAndRecycle(),
+     and sets 'frameSeconds' to how much new audio it covers.
+     */
+    bool getFFTData(int channel, std::vector<float>& fftData, float& frameSeconds)
+    {
+        if( ! fftDataFifos[channel].pullAndRecycle(fftData) )
+            return false;
+        
+        frameSeconds = frameDurations[channel].pull();
+        return true;
+    }
+private:
+    struct Stage
+    {
+        //feed this stage from the one above it, unused on the top stage
+        std::array<HalfBandDecimator, numChannels> decimators;
+        
+        //the newest fftSize samples at this stage's rate
+        std::array<std::vector<float>, numChannels> samples;
+        
+        //the latest spectrum of each channel, in dB
+        std::array<std::vector<float>, numChannels> spectra;
+        
+        int newSamples = 0;
+        
+        //which output points this stage fills, and from which of its bins
+        int firstPoint = 0;
+        std::vector<AnalyzerKernels::ColumnRange> columns;
+    };
+    
+    const std::shared_ptr<const FFTPlan> plan;
+    
+    const SpectrumLayout layout;
+    
+    std::vector<Stage> stages;
+    double preparedSampleRate = 0.0;
+    
+    std::vector<float> fftBuffer, decimated;
+    
+    std::array<Fifo<std::vector<float>>, numChannels> fftDataFifos;
+    
+    //input samples (at the full rate) since the last frame was made
+    int samplesSinceLastFrame = 0;
+    
+    /*
+     The duration of every frame in a channel's FIFO, oldest first.
+     An entry is only pushed when its frame was, and popped when its frame is,
+     so the two stay in step. The same capacity as Fifo, so this never fills up first.
+     */
+    struct FrameDurations
+    {
+        static constexpr int capacity = 30;
+        
+        void push(float seconds)
+        {
+            const juce::AbstractFifo::ScopedWrite write(fifo, 1);
+            if( write.blockSize1 > 0 )
+                durations[static_cast<size_t>(write.startIndex1)] = seconds;
+        }
+        
+        float pull()
+        {
+            const juce::AbstractFifo::ScopedRead read(fifo, 1);
+            return read.blockSize1 > 0 ? durations[static_cast<size_t>(read.startIndex1)] : 0.f;
+        }
+    private:
+        juce::AbstractFifo fifo { capacity };
+        std::array<float, capacity> durations;
+    };
+    
+    std::array<FrameDurations, numChannels> frameDurations;
+    
+    //slides 'samples' along by 'numSamples' and copies the new ones onto the end
+    static void appendSamples(std::vector<float>& samples, const float* data, int numSamples)
+    {
+        const auto size = static_cast<int>(samples.size());
+        
+        if( numSamples >= size )
+        {
+            std::copy(data + numSamples - size, data + numSamples, samples.begin());
+            return;
+        }
+        
+        std::copy(samples.begin() + numSamples, samples.end(), samples.begin());
+        std::copy(data, data + numSamples, samples.end() - numSamples);
+    }
+};
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    ParameterSubscription.h
+    Created: 19 Oct 2026 9:24:52pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Listens to a handful of chosen parameters, and nothing else.
+ 
+ Each subscribed parameter gets one bit. A change (which can come from the audio thread
+ during automation) just ORs that bit into an atomic mask, and the GUI takes the whole mask
+ once per frame, so any amount of automation costs the audio thread one atomic OR per change
+ and the GUI one exchange per frame.
+ */
+struct ParameterSubscription : juce::AudioProcessorParameter::Listener
+{
+    using Mask = uint32_t;
+    
+    static constexpr int maxParameters = 32;
+    
+    ~ParameterSubscription() override
+    {
+        if( ! isListening )
+            return;
+        
+        for( int i = 0; i < numSubscribed; ++i )
+            subscribed[i]->removeListener(this);
+    }
+    
+    /**
+     Message thread, before startListening().
+     Returns the bit that stands for 'param' in the masks takeChanges() returns.
+     */
+    Mask subscribe(juce::AudioProcessorParameter& param)
+    {
+        //the lookup table can't change once the callbacks are reading it
+        jassert( ! isListening );
+        jassert( numSubscribed < maxParameters );
+        
+        const auto bit = Mask(1) << numSubscribed;
+        subscribed[numSubscribed++] = &param;
+        
+        //the callbacks only get the index, so it is turned into the bit with a lookup
+        const auto index = param.getParameterIndex();
+        jassert( index >= 0 );
+        
+        if( index >= static_cast<int>(bitsByIndex.size()) )
+            bitsByIndex.resize(static_cast<size_t>(index) + 1, 0);
+        
+        bitsByIndex[static_cast<size_t>(index)] |= bit;
+        
+        return bit;
+    }
+    
+    //Message thread, once everything is subscribed
+    void startListening()
+    {
+        jassert( ! isListening );
+        isListening = true;
+        
+        for( int i = 0; i < numSubscribed; ++i )
+            subscribed[i]->addListener(this);
+    }
+    
+    //Any thread. Returns the bits of every parameter that changed since the last call, and clears them.
+    Mask takeChanges() { return changedParameters.exchange(0); }
+    
+    void parameterValueChanged(int parameterIndex, float) override
+    {
+        //only subscribed parameters call this, so the index is always in the table
+        changedParameters.fetch_or(bitsByIndex[static_cast<size_t>(parameterIndex)], std::memory_order_relaxed);
+    }
+    
+    void parameterGestureChanged(int, bool) override { }
+private:
+    std::array<juce::AudioProcessorParameter*, maxParameters> subscribed { };
+    int numSubscribed = 0;
+    
+    std::vector<Mask> bitsByIndex;
+    bool isListening = false;
+    
+    std::atomic<Mask> changedParameters { 0 };
+};
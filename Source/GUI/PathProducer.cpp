@@ -1,82 +1,336 @@
-/*
-  ==============================================================================
-
-    PathProducer.cpp
-    Created: 29 Mar 2024 7:29:10pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#include "PathProducer.h"
-
-
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
-{
-    /*
-     This is where we bring together the following to draw the spectrum analyzer:
-     
-     Our SingleChannelSampleFifo (SCSF)
-     The FFT Data Generator
-     Our Path Producer
-     The GUI
-    */
-
-    juce::AudioBuffer<float> tempIncomingBuffer;
-
-    // While there are buffers to pull from SCSF, if we can pull a buffer, we send it to the FFT Data Generator
-    // We need to be very careful to keep blocks in the same order throughout
-    while( leftChannelFifo->getNumCompleteBuffersAvailable() > 0 )
-    {
-        if( leftChannelFifo->getAudioBuffer(tempIncomingBuffer) )
-        {
-            auto size = tempIncomingBuffer.getNumSamples();
-            
-            jassert( size <= monoBuffer.getNumSamples() );
-            size = juce::jmin(size, monoBuffer.getNumSamples());
-            
-            
-            // First, shift everything in the monoBuffer forward by however many samples are in the tempIncomingBuffer
-            
-            auto writePointer = monoBuffer.getWritePointer(0, 0);
-            auto readPointer = monoBuffer.getReadPointer(0, size);
-            
-            std::copy(readPointer, //location of first sample in the source we want to copy
-                      readPointer + (monoBuffer.getNumSamples() - size), //location of last sample + 1 that we want to copy
-                      writePointer); //destination buffer
-            
-//            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0,0),
-//                                              monoBuffer.getReadPointer(0, size),
-//                                              monoBuffer.getNumSamples() - size);
-            
-            // Then, copy the samples from the tempIncomingBuffer to the monoBuffer
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0,monoBuffer.getNumSamples() - size),
-                                              tempIncomingBuffer.getReadPointer(0,0),
-                                              size);
-            
-            // Send monoBuffers to the FFT Data Generator
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negativeInfinity);
-        }
-    }
-    
-    // While there are FFT data buffers to pull, if we can pull a buffer, generatae a path
-    
-    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
-    const auto binWidth = sampleRate / double(fftSize);
-    
-    while( leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0 )
-    {
-        std::vector<float> fftData;
-        if( leftChannelFFTDataGenerator.getFFTData(fftData) )
-        {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, negativeInfinity);
-        }
-    }
-    
-    // While there are paths that can be pulled, pull as many as we can & display the most recent path
-    
-    while( pathProducer.getNumPathsAvailable() > 0 )
-    {
-        pathProducer.getPath(leftChannelFFTPath);
-    }
-}
+/*
+  ==============================================================================
+
+    PathProducer.cpp
+    Created: 29 Mar 2024 7:29:10pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "PathProducer.h"
+
+
+void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate, bool produceSpectrum)
+{
+    /*
+     This is where we bring together the following to draw the spectrum analyzer:
+     
+     Our SingleChannelSampleFifo (SCSF)
+     The FFT Data Generator
+     Our Path Producer
+     The GUI
+    */
+
+    //If a new FFT order has been built in the background, start using it now
+    fftDataGenerator.applyPendingEngine();
+    
+    //With the spectrum hidden, or before the first plan arrives, there is nothing to analyse.
+    //The blocks are still drained so the stereo image keeps up, only the FFT work is skipped.
+    if( ! produceSpectrum || ! fftDataGenerator.hasEngine() )
+    {
+        multiResolutionWasUsed = false;
+        processStereoImageOnly(sampleRate);
+        return;
+    }
+    
+    auto& stereoBuffer = fftDataGenerator.getInputBuffer();
+    
+    //The multi-resolution analyzer keeps filter state between blocks,
+    //so its history is thrown away whenever it hasn't been fed for a while
+    const bool multiResolution = useMultiResolution;
+    
+    if( multiResolution )
+    {
+        if( multiResolutionAnalyzer == nullptr )
+            multiResolutionAnalyzer = std::make_unique<MultiResolutionAnalyzer>();
+        
+        multiResolutionAnalyzer->prepare(sampleRate);
+        
+        if( ! multiResolutionWasUsed )
+            multiResolutionAnalyzer->reset();
+    }
+    
+    multiResolutionWasUsed = multiResolution;
+    
+    // While there are buffers to pull from both SCSFs, pull one from each and send them to the FFT Data Generator
+    // We need to be very careful to keep blocks in the same order throughout, and both channels in step
+    while( getNumBuffersAvailable() > 0 )
+    {
+        for( int channel = 0; channel < stereoBuffer.getNumChannels(); ++channel )
+        {
+            if( ! channelFifos[channel]->getAudioBuffer(incomingBuffer) )
+                continue;
+            
+            auto size = incomingBuffer.getNumSamples();
+            hopSize = size;
+            
+            addToStereoImageBlock(channel);
+            
+            if( multiResolution )
+            {
+                multiResolutionAnalyzer->pushSamples(channel, incomingBuffer.getReadPointer(0), size);
+                continue;
+            }
+            
+            jassert( size <= stereoBuffer.getNumSamples() );
+            size = juce::jmin(size, stereoBuffer.getNumSamples());
+            
+            // First, shift everything in this channel of the stereoBuffer forward by however many samples are in the incomingBuffer
+            
+            auto writePointer = stereoBuffer.getWritePointer(channel, 0);
+            auto readPointer = stereoBuffer.getReadPointer(channel, size);
+            
+            std::copy(readPointer, //location of first sample in the source we want to copy
+                      readPointer + (stereoBuffer.getNumSamples() - size), //location of last sample + 1 that we want to copy
+                      writePointer); //destination buffer
+            
+            // Then, copy the samples from the incomingBuffer to the stereoBuffer
+            juce::FloatVectorOperations::copy(stereoBuffer.getWritePointer(channel, stereoBuffer.getNumSamples() - size),
+                                              incomingBuffer.getReadPointer(0,0),
+                                              size);
+        }
+        
+        analyseStereoImageBlock(sampleRate);
+        
+        // Send the stereoBuffer to the FFT Data Generator
+        if( multiResolution )
+            multiResolutionAnalyzer->produceFFTDataForRendering(negativeInfinity.load());
+        else if( useStereoPacking )
+            fftDataGenerator.produceStereoFFTDataForRendering(stereoBuffer, negativeInfinity.load());
+        else
+            fftDataGenerator.produceFFTDataForRendering(stereoBuffer, negativeInfinity.load());
+    }
+    
+    // While there are FFT data buffers to pull, feed every one of them through the smoother,
+    // then generate one path from the smoothed result, and leave it in the path FIFOs for pullPaths()
+    
+    const auto fftSize = fftDataGenerator.getFFTSize();
+    const auto binWidth = static_cast<float>(sampleRate / double(fftSize));
+    const auto layout = multiResolution ?
+                        multiResolutionAnalyzer->getLayout() :
+                        SpectrumLayout::linear(fftSize / 2, binWidth);
+    
+    //a plain FFT frame is made for every block, so it covers one block.
+    //The multi-resolution analyzer says what each of its frames covers.
+    const auto blockSeconds = sampleRate > 0.0 ? static_cast<float>(hopSize / sampleRate) : 0.f;
+    const auto negInf = negativeInfinity.load();
+    
+    binToPixelMap.update(juce::roundToInt(fftBounds.getWidth()), layout);
+    
+    //silent paths still have to be regenerated once if the area they are drawn in changed
+    if( fftBounds != lastFFTBounds )
+    {
+        lastFFTBounds = fftBounds;
+        channelIsSilent.fill(false);
+    }
+    
+    auto isAtFloor = [negInf](const std::vector<float>& levels)
+    {
+        //anything this close to negative infinity is drawn on the bottom edge anyway
+        return juce::FloatVectorOperations::findMaximum(levels.data(), (int)levels.size()) < negInf + 0.1f;
+    };
+    
+    for( auto& smoother : smoothers )
+        smoother.prepare(layout);
+    
+    std::array<bool, 2> receivedNewData { false, false };
+    
+    // Both channels are drained in step, so each pair of blocks can also go to the spectrogram
+    auto getNumAvailableBlocks = [this, multiResolution](int channel)
+    {
+        return multiResolution ?
+               multiResolutionAnalyzer->getNumAvailableFFTDataBlocks(channel) :
+               fftDataGenerator.getNumAvailableFFTDataBlocks(channel);
+    };
+    
+    auto numBlocksAvailable = [&getNumAvailableBlocks]()
+    {
+        return juce::jmax(getNumAvailableBlocks(Channel::Left),
+                          getNumAvailableBlocks(Channel::Right));
+    };
+    
+    auto getBlock = [this, multiResolution, blockSeconds](int channel, std::vector<float>& block, float& frameSeconds)
+    {
+        frameSeconds = blockSeconds;
+        
+        return multiResolution ?
+               multiResolutionAnalyzer->getFFTData(channel, block, frameSeconds) :
+               fftDataGenerator.getFFTData(channel, block);
+    };
+    
+    while( numBlocksAvailable() > 0 )
+    {
+        std::array<bool, 2> pulled { false, false };
+        std::array<float, 2> frameSeconds { 0.f, 0.f };
+        
+        for( int channel = 0; channel < static_cast<int>(smoothers.size()); ++channel )
+        {
+            if( getBlock(channel, fftDataBlocks[channel], frameSeconds[channel]) )
+            {
+                smoothers[channel].process(fftDataBlocks[channel], frameSeconds[channel]);
+                receivedNewData[channel] = pulled[channel] = true;
+            }
+        }
+        
+        if( spectrogramEnabled && pulled[Channel::Left] && pulled[Channel::Right] )
+        {
+            spectrogramGenerator.addFrame(fftDataBlocks[Channel::Left],
+                                          fftDataBlocks[Channel::Right],
+                                          layout,
+                                          frameSeconds[Channel::Left]);
+        }
+    }
+    
+    bool spectrumChanged = false;
+    
+    for( int channel = 0; channel < static_cast<int>(pathProducers.size()); ++channel )
+    {
+        auto& smoother = smoothers[channel];
+        
+        if( receivedNewData[channel] )
+        {
+            auto isSilent = isAtFloor(smoother.getAveraged()) && isAtFloor(smoother.getPeaks());
+            
+            if( isSilent && channelIsSilent[channel] )
+                continue;
+            
+            channelIsSilent[channel] = isSilent;
+            spectrumChanged = true;
+            
+            pathProducers[channel].generatePath(smoother.getAveraged(), binToPixelMap, fftBounds, negInf);
+            peakPathProducers[channel].generatePath(smoother.getPeaks(), binToPixelMap, fftBounds, negInf);
+        }
+    }
+    
+    generateBandPaths(fftBounds, layout, spectrumChanged, negInf);
+}
+
+void PathProducer::generateBandPaths(juce::Rectangle<float> fftBounds,
+                                     const SpectrumLayout& layout,
+                                     bool spectrumChanged,
+                                     float negInf)
+{
+    const bool enabled = bandShadingEnabled;
+    const bool wasEnabled = bandShadingWasEnabled;
+    bandShadingWasEnabled = enabled;
+    
+    if( ! enabled )
+        return;
+    
+    //a crossover that moved changes the bands even when the spectrum didn't,
+    //and so does switching this on while the audio is silent
+    auto responsesChanged = crossoverResponses.update(layout, lowMidFrequency.load(), midHighFrequency.load());
+    
+    if( ! spectrumChanged && ! responsesChanged && wasEnabled )
+        return;
+    
+    //one shading for both channels: the louder of the two, bin by bin
+    const auto& left = smoothers[Channel::Left].getAveraged();
+    const auto& right = smoothers[Channel::Right].getAveraged();
+    const auto numBins = static_cast<int>(juce::jmin(left.size(), right.size()));
+    
+    combinedSpectrum.resize(static_cast<size_t>(numBins));
+    juce::FloatVectorOperations::max(combinedSpectrum.data(), left.data(), right.data(), numBins);
+    
+    for( int band = 0; band < CrossoverResponses::numBands; ++band )
+    {
+        crossoverResponses.apply(band, combinedSpectrum, bandSpectrum, negInf);
+        bandPathProducers[band].generatePath(bandSpectrum, binToPixelMap, fftBounds, negInf);
+    }
+}
+
+int PathProducer::getNumBuffersAvailable() const
+{
+    return juce::jmin(channelFifos[Channel::Left]->getNumCompleteBuffersAvailable(),
+                      channelFifos[Channel::Right]->getNumCompleteBuffersAvailable());
+}
+
+void PathProducer::processStereoImageOnly(double sampleRate)
+{
+    while( getNumBuffersAvailable() > 0 )
+    {
+        for( int channel = 0; channel < 2; ++channel )
+        {
+            if( channelFifos[channel]->getAudioBuffer(incomingBuffer) )
+                addToStereoImageBlock(channel);
+        }
+        
+        analyseStereoImageBlock(sampleRate);
+    }
+}
+
+void PathProducer::addToStereoImageBlock(int channel)
+{
+    if( stereoImageAnalysis == nullptr )
+        return;
+    
+    auto size = incomingBuffer.getNumSamples();
+    stereoImageBlock.setSize(2, size, false, false, true);
+    stereoImageBlock.copyFrom(channel, 0, incomingBuffer, 0, 0, size);
+}
+
+void PathProducer::analyseStereoImageBlock(double sampleRate)
+{
+    if( stereoImageAnalysis == nullptr )
+        return;
+    
+    stereoImageAnalysis->process(stereoImageBlock.getReadPointer(Channel::Left),
+                                 stereoImageBlock.getReadPointer(Channel::Right),
+                                 stereoImageBlock.getNumSamples(),
+                                 sampleRate);
+}
+
+bool PathProducer::pullPaths()
+{
+    // While there are paths that can be pulled, pull as many as we can & display the most recent path
+    
+    bool pulledNewPaths = false;
+    
+    for( size_t channel = 0; channel < pathProducers.size(); ++channel )
+    {
+        while( pathProducers[channel].getNumPathsAvailable() > 0 )
+        {
+            pulledNewPaths |= pathProducers[channel].getPath(channelFFTPaths[channel]);
+        }
+        
+        while( peakPathProducers[channel].getNumPathsAvailable() > 0 )
+        {
+            pulledNewPaths |= peakPathProducers[channel].getPath(channelPeakPaths[channel]);
+        }
+    }
+    
+    for( size_t band = 0; band < bandPathProducers.size(); ++band )
+    {
+        while( bandPathProducers[band].getNumPathsAvailable() > 0 )
+        {
+            pulledNewPaths |= bandPathProducers[band].getPath(bandPaths[band]);
+        }
+    }
+    
+    return pulledNewPaths;
+}
+
+bool PathProducer::pullSpectrogramColumns(SpectrogramImage& spectrogram)
+{
+    // Unlike the paths, every column is kept: each one is a slice of the history
+    
+    bool pulledNewColumns = false;
+    
+    while( spectrogramGenerator.getNumColumnsAvailable() > 0 )
+    {
+        if( spectrogramGenerator.getColumn(spectrogramColumn) )
+        {
+            spectrogram.addColumn(spectrogramColumn);
+            pulledNewColumns = true;
+        }
+    }
+    
+    return pulledNewColumns;
+}
+
+void PathProducer::postPlan(std::shared_ptr<const FFTPlan> newPlan)
+{
+    using Generator = decltype(fftDataGenerator);
+    fftDataGenerator.postEngine(Generator::createEngine(std::move(newPlan)));
+}
@@ -1,42 +1,179 @@
-/*
-  ==============================================================================
-
-    PathProducer.h
-    Created: 29 Mar 2024 7:29:10pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "../PluginProcessor.h"
-#include "FFTDataGenerator.h"
-#include "FFTOrder.h"
-#include "AnalyzerPathGenerator.h"
-
-struct PathProducer
-{
-    PathProducer(SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>& scsf) :
-    leftChannelFifo(&scsf)
-    {
-        leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
-        monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
-    }
-    void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
-    
-    void updateNegativeInfinity(float nf) { negativeInfinity = nf; }
-private:
-    SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>* leftChannelFifo;
-    
-    juce::AudioBuffer<float> monoBuffer;
-    
-    FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
-    
-    AnalyzerPathGenerator<juce::Path> pathProducer;
-    
-    juce::Path leftChannelFFTPath;
-    
-    float negativeInfinity { -48.f };
-};
+/*
+  ==============================================================================
+
+    PathProducer.h
+    Created: 29 Mar 2024 7:29:10pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "FFTDataGenerator.h"
+#include "FFTOrder.h"
+#include "AnalyzerPathGenerator.h"
+#include "SpectrumSmoother.h"
+#include "Spectrogram.h"
+#include "MultiResolutionAnalyzer.h"
+#include "CrossoverResponses.h"
+#include "StereoImageAnalysis.h"
+
+/*
+ Turns a stereo pair of SCSFs into spectrum paths.
+ 
+ process() does all of the analysis and is meant to run on a background thread.
+ The paths it produces are handed over through lock-free FIFOs and picked up on the
+ message thread with pullPaths(), after which getPath()/getPeakPath() are safe to draw.
+ 
+ Nothing is allocated for the analysis until a plan is posted with postPlan(),
+ so a producer costs next to nothing until its analyzer is actually shown.
+ */
+struct PathProducer
+{
+    using SCSF = SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>;
+    
+    PathProducer(SCSF& leftScsf,
+                 SCSF& rightScsf,
+                 BinToPixelMap& sharedBinToPixelMap) :
+    binToPixelMap(sharedBinToPixelMap)
+    {
+        channelFifos[Channel::Left] = &leftScsf;
+        channelFifos[Channel::Right] = &rightScsf;
+        
+        for( auto& bandPathProducer : bandPathProducers )
+            bandPathProducer.setClosed(true);
+    }
+    
+    /**
+     Analysis thread. Drains the SCSFs into the stereo image analysis, and into the spectrum
+     when 'produceSpectrum' is set. Without it the blocks are only passed to the stereo image.
+     */
+    void process(juce::Rectangle<float> fftBounds, double sampleRate, bool produceSpectrum);
+    
+    //message thread
+    bool pullPaths();
+    const juce::Path& getPath(Channel channel) const { return channelFFTPaths[channel]; }
+    const juce::Path& getPeakPath(Channel channel) const { return channelPeakPaths[channel]; }
+    const juce::Path& getBandPath(int band) const { return bandPaths[band]; }
+    
+    void updateNegativeInfinity(float nf) { negativeInfinity = nf; }
+    
+    /**
+     When enabled (the default), both channels are analysed with one complex FFT
+     instead of one real FFT each. The resulting paths are the same either way.
+     */
+    void setStereoPacking(bool shouldPack) { useStereoPacking = shouldPack; }
+    
+    /**
+     When enabled, the paths come from the MultiResolutionAnalyzer instead of the
+     single FFT, which resolves the low end much more finely. The FFT order is ignored.
+     */
+    void setMultiResolution(bool shouldUseMultiResolution) { useMultiResolution = shouldUseMultiResolution; }
+    
+    /**
+     When enabled, every FFT frame is also reduced to a spectrogram column.
+     'numRows' and 'numColumns' should match the SpectrogramImage the columns are pulled into.
+     */
+    void setSpectrogramEnabled(bool shouldBeEnabled) { spectrogramEnabled = shouldBeEnabled; }
+    void setSpectrogramSize(int numRows, int numColumns) { spectrogramGenerator.setSize(numRows, numColumns); }
+    void setSpectrogramHistoryLength(float seconds) { spectrogramGenerator.setHistoryLength(seconds); }
+    
+    /**
+     When enabled, the averaged spectrum of both channels is also split into the compressor's
+     bands with CrossoverResponses, giving one closed path per band from getBandPath().
+     The responses are only recomputed when setCrossoverFrequencies() changes them.
+     */
+    void setBandShading(bool shouldBeEnabled) { bandShadingEnabled = shouldBeEnabled; }
+    void setCrossoverFrequencies(float lowMid, float midHigh)
+    {
+        lowMidFrequency = lowMid;
+        midHighFrequency = midHigh;
+    }
+    
+    /**
+     Also hands every stereo block pulled from the SCSFs to 'analysis', on the analysis thread.
+     Set it before the analysis starts. It has to outlive the analysis.
+     */
+    void setStereoImageAnalysis(StereoImageAnalysis* analysis) { stereoImageAnalysis = analysis; }
+    
+    //message thread, writes any finished columns into 'spectrogram'
+    bool pullSpectrogramColumns(SpectrogramImage& spectrogram);
+    
+    /**
+     Builds this producer's buffers for 'newPlan' on the calling thread and hands them over.
+     They are swapped in at the start of a later process() call, so the
+     analyzer keeps drawing at the old order until the new one is ready.
+     */
+    void postPlan(std::shared_ptr<const FFTPlan> newPlan);
+private:
+    std::array<SCSF*, 2> channelFifos;
+    
+    FFTDataGenerator<std::vector<float>> fftDataGenerator;
+    
+    //only built the first time multi-resolution is switched on, on the analysis thread
+    std::unique_ptr<MultiResolutionAnalyzer> multiResolutionAnalyzer;
+    
+    //every FFT frame goes through these, the paths are drawn from their output
+    std::array<SpectrumSmoother, 2> smoothers;
+    
+    //owned by the SpectrumAnalyzer and only touched from the analysis thread
+    BinToPixelMap& binToPixelMap;
+    
+    std::array<AnalyzerPathGenerator<juce::Path>, 2> pathProducers, peakPathProducers;
+    
+    //Scratch storage reused every frame, so process() doesn't allocate
+    juce::AudioBuffer<float> incomingBuffer;
+    std::array<std::vector<float>, 2> fftDataBlocks;
+    std::vector<float> spectrogramColumn;
+    
+    std::array<juce::Path, 2> channelFFTPaths, channelPeakPaths;
+    
+    //Once a channel has decayed to silence its path stops changing,
+    //so no new paths are produced for it until it has signal again.
+    //That lets the analyzer stop repainting while the audio is silent.
+    std::array<bool, 2> channelIsSilent { false, false };
+    juce::Rectangle<float> lastFFTBounds;
+    
+    //how many new samples each FFT frame covers, i.e. the SCSF buffer size
+    int hopSize = 0;
+    
+    std::atomic<float> negativeInfinity { -48.f };
+    
+    std::atomic<bool> useStereoPacking { true };
+    
+    std::atomic<bool> useMultiResolution { false };
+    bool multiResolutionWasUsed = false;
+    
+    SpectrogramColumnGenerator spectrogramGenerator;
+    std::atomic<bool> spectrogramEnabled { false };
+    
+    CrossoverResponses crossoverResponses;
+    std::array<AnalyzerPathGenerator<juce::Path>, CrossoverResponses::numBands> bandPathProducers;
+    std::array<juce::Path, CrossoverResponses::numBands> bandPaths;
+    std::vector<float> combinedSpectrum, bandSpectrum;
+    
+    StereoImageAnalysis* stereoImageAnalysis = nullptr;
+    
+    //incomingBuffer only ever holds one channel, the stereo image needs both at once
+    juce::AudioBuffer<float> stereoImageBlock;
+    
+    std::atomic<bool> bandShadingEnabled { false };
+    bool bandShadingWasEnabled = false;
+    std::atomic<float> lowMidFrequency { 0.f }, midHighFrequency { 0.f };
+    
+    //both SCSFs are pulled in step, so this is how many pairs of blocks are ready
+    int getNumBuffersAvailable() const;
+    
+    void processStereoImageOnly(double sampleRate);
+    
+    //the channel in incomingBuffer goes into stereoImageBlock, and once both are in it is analysed
+    void addToStereoImageBlock(int channel);
+    void analyseStereoImageBlock(double sampleRate);
+    
+    void generateBandPaths(juce::Rectangle<float> fftBounds,
+                           const SpectrumLayout& layout,
+                           bool spectrumChanged,
+                           float negInf);
+};
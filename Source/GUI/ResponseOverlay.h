@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    ResponseOverlay.h
+    Created: 19 Oct 2026 8:51:38pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utilities.h"
+#include "CrossoverResponses.h"
+
+/*
+ The analyzer's overlay of what the processor does to a steady signal:
+ the magnitude response of each band of the crossover, and each band's static compression curve.
+ 
+ None of it changes unless a crossover, threshold or ratio does (or the analyzer is resized),
+ so the paths are built once on a background thread and just stroked on every repaint after that.
+ */
+struct ResponseOverlay
+{
+    static constexpr int numBands = CrossoverResponses::numBands;
+    
+    //everything the paths depend on
+    struct Settings
+    {
+        float lowMidFrequency = 0.f, midHighFrequency = 0.f;
+        std::array<float, numBands> thresholds { }, ratios { };
+        juce::Rectangle<float> area;
+        
+        bool operator==(const Settings& other) const
+        {
+            return lowMidFrequency == other.lowMidFrequency
+                && midHighFrequency == other.midHighFrequency
+                && thresholds == other.thresholds
+                && ratios == other.ratios
+                && area == other.area;
+        }
+        
+        bool operator!=(const Settings& other) const { return ! (*this == other); }
+    };
+    
+    struct Paths
+    {
+        //across the whole area, on the analyzer's dB scale, so 0dB is the passband
+        std::array<juce::Path, numBands> bandResponses;
+        
+        //in each band's own part of the area: input level left to right, output level bottom to top,
+        //both on the analyzer's dB scale
+        std::array<juce::Path, numBands> transferCurves;
+        
+        //the area they were built for, so they can be stretched into another one until they are rebuilt
+        juce::Rectangle<float> area;
+    };
+    
+    ~ResponseOverlay()
+    {
+        delete pendingPaths.exchange(nullptr);
+    }
+    
+    /**
+     Message thread.
+     Starts building new paths on 'pool' if 'settings' differ from the last ones asked for.
+     The pool must finish its jobs before this is destroyed.
+     */
+    void update(const Settings& settings, juce::ThreadPool& pool)
+    {
+        if( settings == requestedSettings )
+            return;
+        
+        requestedSettings = settings;
+        
+        pool.addJob([this, settings]()
+        {
+            //if an earlier set of paths was never picked up, it is out of date anyway
+            delete pendingPaths.exchange(build(settings).release());
+        });
+    }
+    
+    //Message thread. Swaps in the newest finished paths and returns true if there were any.
+    bool pullPaths()
+    {
+        std::unique_ptr<Paths> newPaths(pendingPaths.exchange(nullptr));
+        
+        if( newPaths == nullptr )
+            return false;
+        
+        paths = std::move(newPaths);
+        return true;
+    }
+    
+    //nullptr until the first paths are finished
+    const Paths* getPaths() const { return paths.get(); }
+    
+    static std::unique_ptr<Paths> build(const Settings& settings)
+    {
+        using namespace juce;
+        
+        auto newPaths = std::make_unique<Paths>();
+        const auto& area = settings.area;
+        newPaths->area = area;
+        
+        if( area.isEmpty() )
+            return newPaths;
+        
+        //a little below the bottom, so the steep skirts run off the area instead of along its edge
+        auto mapY = [&area](float db)
+        {
+            db = jmax(db, NEGATIVE_INFINITY - 6.f);
+            return jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, area.getBottom(), area.getY());
+        };
+        
+        //one point per pixel column
+        const auto numColumns = roundToInt(area.getWidth());
+        
+        for( auto& path : newPaths->bandResponses )
+            path.preallocateSpace(3 * numColumns);
+        
+        for( int x = 0; x < numColumns; ++x )
+        {
+            auto frequency = mapToLog10(float(x) / area.getWidth(), MIN_FREQUENCY, MAX_FREQUENCY);
+            auto gains = CrossoverResponses::getBandGainsDb(frequency, settings.lowMidFrequency, settings.midHighFrequency);
+            
+            for( int band = 0; band < numBands; ++band )
+            {
+                Point<float> point(area.getX() + x, mapY(gains[band]));
+                auto& path = newPaths->bandResponses[band];
+                
+                if( x == 0 )
+                    path.startNewSubPath(point);
+                else
+                    path.lineTo(point);
+            }
+        }
+        
+        auto mapX = [&area](float frequency)
+        {
+            return area.getX() + area.getWidth() * mapFromLog10(frequency, MIN_FREQUENCY, MAX_FREQUENCY);
+        };
+        
+        const std::array<float, numBands + 1> bandEdges
+        {
+            area.getX(),
+            mapX(settings.lowMidFrequency),
+            mapX(settings.midHighFrequency),
+            area.getRight()
+        };
+        
+        //the compressors have a hard knee, so each curve is two straight lines
+        for( int band = 0; band < numBands; ++band )
+        {
+            auto left = bandEdges[band];
+            auto right = bandEdges[band + 1];
+            
+            if( right <= left )
+                continue;
+            
+            auto threshold = settings.thresholds[band];
+            auto ratio = jmax(1.f, settings.ratios[band]);
+            
+            auto inputToX = [left, right](float db)
+            {
+                return jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, left, right);
+            };
+            
+            auto& path = newPaths->transferCurves[band];
+            path.startNewSubPath(left, mapY(NEGATIVE_INFINITY));
+            path.lineTo(inputToX(threshold), mapY(threshold));
+            path.lineTo(right, mapY(threshold + (MAX_DECIBELS - threshold) / ratio));
+        }
+        
+        return newPaths;
+    }
+private:
+    Settings requestedSettings;
+    std::unique_ptr<Paths> paths;
+    std::atomic<Paths*> pendingPaths { nullptr };
+};
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    ScrollingImage.h
+    Created: 19 Oct 2026 6:58:40pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ A circular image for displays that scroll right to left, one pixel column at a time.
+ 
+ Every new column overwrites the oldest one, so adding a column only touches that column.
+ Drawing is two blits, oldest part first, so nothing already on screen is ever re-rendered.
+ */
+struct ScrollingImage
+{
+    /**
+     Resizes the ring, which throws the history away.
+     Does nothing if the size hasn't changed.
+     */
+    void setSize(int width, int height)
+    {
+        if( width == image.getWidth() && height == image.getHeight() )
+            return;
+        
+        image = (width > 0 && height > 0) ? juce::Image(juce::Image::RGB, width, height, true) : juce::Image();
+        writePosition = 0;
+    }
+    
+    bool isNull() const { return image.isNull(); }
+    int getWidth() const { return image.getWidth(); }
+    int getHeight() const { return image.getHeight(); }
+    
+    /**
+     Overwrites the oldest column.
+     'writeColumn' gets a juce::Image::BitmapData for a 1 pixel wide, full height column
+     of PixelRGB, and must write every pixel of it.
+     */
+    template<typename WriteFunction>
+    void addColumn(WriteFunction&& writeColumn)
+    {
+        if( image.isNull() )
+            return;
+        
+        {
+            juce::Image::BitmapData pixels(image, writePosition, 0, 1, image.getHeight(), juce::Image::BitmapData::writeOnly);
+            writeColumn(pixels);
+        }
+        
+        writePosition = (writePosition + 1) % image.getWidth();
+    }
+    
+    /**
+     Draws the ring, oldest column on the left, into 'area'.
+     That should be the ring's size, but it is stretched to fit if it isn't (i.e. during a live resize).
+     */
+    void draw(juce::Graphics& g, juce::Rectangle<int> area) const
+    {
+        if( image.isNull() )
+            return;
+        
+        const auto width = image.getWidth();
+        const auto height = image.getHeight();
+        const auto olderWidth = width - writePosition;
+        
+        //where the seam between the two parts lands in 'area'
+        const auto seam = area.getX() + juce::roundToInt(olderWidth * area.getWidth() / static_cast<double>(width));
+        
+        //the blits are 1:1 in logical pixels (a live resize is over too quickly to be worth filtering)
+        juce::Graphics::ScopedSaveState sss(g);
+        g.setImageResamplingQuality(juce::Graphics::lowResamplingQuality);
+        
+        g.drawImage(image,
+                    area.getX(), area.getY(), seam - area.getX(), area.getHeight(),
+                    writePosition, 0, olderWidth, height);
+        
+        if( writePosition > 0 )
+        {
+            g.drawImage(image,
+                        seam, area.getY(), area.getRight() - seam, area.getHeight(),
+                        0, 0, writePosition, height);
+        }
+    }
+private:
+    juce::Image image;
+    int writePosition = 0;
+};
@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    Spectrogram.h
+    Created: 19 Oct 2026 4:05:52pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utilities.h"
+#include "AnalyzerPathGenerator.h"
+#include "ScrollingImage.h"
+
+/*
+ The analysis-thread half of the spectrogram.
+ 
+ Reduces FFT frames to one level per pixel row (lowest frequency first) and hands
+ them to the message thread through a FIFO, one column at a time.
+ If one frame per column would show less history than asked for, several frames
+ are combined into each column, keeping the loudest level of each row.
+ */
+struct SpectrogramColumnGenerator
+{
+    //message thread
+    void setSize(int newNumRows, int newNumColumns)
+    {
+        numRows = newNumRows;
+        numColumns = newNumColumns;
+    }
+    
+    void setHistoryLength(float seconds) { historySeconds = seconds; }
+    
+    //analysis thread
+    void addFrame(const std::vector<float>& leftFrame,
+                  const std::vector<float>& rightFrame,
+                  const SpectrumLayout& layout,
+                  float frameSeconds)
+    {
+        const auto rows = numRows.load();
+        
+        binToRowMap.update(rows, layout);
+        
+        if( binToRowMap.getNumColumns() == 0 )
+            return;
+        
+        if( static_cast<int>(accumulated.size()) != rows )
+        {
+            accumulated.assign(rows, NEGATIVE_INFINITY);
+            framesAccumulated = 0;
+        }
+        
+        leftLevels.resize(rows);
+        rightLevels.resize(rows);
+        
+        AnalyzerKernels::reduceColumns(leftFrame.data(), binToRowMap.getColumns(), rows, AnalyzerKernels::ColumnReduction::peak, leftLevels.data());
+        AnalyzerKernels::reduceColumns(rightFrame.data(), binToRowMap.getColumns(), rows, AnalyzerKernels::ColumnReduction::peak, rightLevels.data());
+        
+        //the louder of the two channels, and the loudest frame since the last column
+        juce::FloatVectorOperations::max(leftLevels.data(), leftLevels.data(), rightLevels.data(), rows);
+        juce::FloatVectorOperations::max(accumulated.data(), accumulated.data(), leftLevels.data(), rows);
+        
+        if( ++framesAccumulated < getFramesPerColumn(frameSeconds) )
+            return;
+        
+        columnFifo.pushInPlace([this](std::vector<float>& column)
+        {
+            column.assign(accumulated.begin(), accumulated.end());
+        });
+        
+        std::fill(accumulated.begin(), accumulated.end(), NEGATIVE_INFINITY);
+        framesAccumulated = 0;
+    }
+    
+    //message thread
+    int getNumColumnsAvailable() const { return columnFifo.getNumAvailableForReading(); }
+    
+    //swaps the oldest column into 'column', see Fifo::pullAndRecycle()
+    bool getColumn(std::vector<float>& column) { return columnFifo.pullAndRecycle(column); }
+private:
+    std::atomic<int> numRows { 0 }, numColumns { 0 };
+    std::atomic<float> historySeconds { 20.f };
+    
+    BinToPixelMap binToRowMap;
+    std::vector<float> leftLevels, rightLevels, accumulated;
+    int framesAccumulated = 0;
+    
+    Fifo<std::vector<float>> columnFifo;
+    
+    int getFramesPerColumn(float frameSeconds) const
+    {
+        const auto columns = numColumns.load();
+        
+        if( frameSeconds <= 0.f || columns <= 0 )
+            return 1;
+        
+        return juce::jmax(1, juce::roundToInt(historySeconds.load() / (frameSeconds * columns)));
+    }
+};
+
+/*
+ The message-thread half of the spectrogram.
+ 
+ The history is kept in a ScrollingImage. Levels are turned into colours
+ through a precomputed table, so adding a column costs one lookup per row.
+ */
+struct SpectrogramImage
+{
+    //One pixel column per column of history, one pixel row per level
+    void setSize(int width, int height) { ring.setSize(width, height); }
+    
+    //writes 'levels' (lowest frequency first, in dB) over the oldest column
+    void addColumn(const std::vector<float>& levels)
+    {
+        const auto& colourTable = getColourTable();
+        const auto imageHeight = ring.getHeight();
+        const auto height = juce::jmin(imageHeight, static_cast<int>(levels.size()));
+        const auto maxIndex = static_cast<float>(colourTable.size() - 1);
+        
+        ring.addColumn([&](juce::Image::BitmapData& pixels)
+        {
+            for( int row = 0; row < imageHeight; ++row )
+            {
+                auto index = 0.f;
+                
+                if( row < height )
+                {
+                    index = juce::jmap(levels[row], NEGATIVE_INFINITY, MAX_DECIBELS, 0.f, maxIndex);
+                    index = juce::jlimit(0.f, maxIndex, index);
+                }
+                
+                //row 0 is the lowest frequency, which goes at the bottom
+                auto* pixel = reinterpret_cast<juce::PixelRGB*>(pixels.getPixelPointer(0, imageHeight - 1 - row));
+                pixel->set(colourTable[static_cast<size_t>(index)]);
+            }
+        });
+    }
+    
+    void draw(juce::Graphics& g, juce::Rectangle<int> area) const { ring.draw(g, area); }
+private:
+    ScrollingImage ring;
+    
+    using ColourTable = std::array<juce::PixelARGB, 256>;
+    
+    //the same for every spectrogram, so there is only one in the process
+    static const ColourTable& getColourTable()
+    {
+        static const auto table = []()
+        {
+            //dark purple -> the analyzer's left/right colours -> white,
+            //so the quiet parts sink into the background
+            juce::ColourGradient gradient(juce::Colours::black, 0.f, 0.f,
+                                          juce::Colours::white, 1.f, 0.f,
+                                          false);
+            gradient.addColour(0.35, juce::Colour(97u, 18u, 167u));
+            gradient.addColour(0.7, juce::Colours::orange);
+            gradient.addColour(0.85, juce::Colour(215u, 201u, 134u));
+            
+            ColourTable t;
+            
+            for( size_t i = 0; i < t.size(); ++i )
+            {
+                auto position = static_cast<double>(i) / static_cast<double>(t.size() - 1);
+                t[i] = gradient.getColourAtPosition(position).getPixelARGB();
+            }
+            
+            return t;
+        }();
+        
+        return table;
+    }
+};
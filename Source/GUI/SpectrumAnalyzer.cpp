@@ -1,382 +1,887 @@
-/*
-  ==============================================================================
-
-    SpectrumAnalyzer.cpp
-    Created: 29 Mar 2024 7:29:16pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#include "SpectrumAnalyzer.h"
-#include "../Utilities.h"
-#include "../DSP/Params.h"
-
-SpectrumAnalyzer::SpectrumAnalyzer(SimpleMBCompAudioProcessor& p) :
-audioProcessor(p),
-leftPathProducer(audioProcessor.leftChannelFifo),
-rightPathProducer(audioProcessor.rightChannelFifo)
-{
-    const auto& params = audioProcessor.getParameters();
-    for( auto param : params )
-    {
-        param->addListener(this);
-    }
-    
-    using namespace Params;
-    
-    const auto& paramNames = GetParams();
-    
-    auto floatHelper = [&apvts = audioProcessor.apvts, &paramNames](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramNames.at(paramName)));
-        jassert(param != nullptr);
-    };
-    
-    floatHelper(lowMidXoverParam, Names::Low_Mid_Crossover_Freq);
-    floatHelper(midHighXoverParam, Names::Mid_High_Crossover_Freq);
-    
-    floatHelper(lowThresholdParam, Names::Threshold_Low_Band);
-    floatHelper(midThresholdParam, Names::Threshold_Mid_Band);
-    floatHelper(highThresholdParam, Names::Threshold_High_Band);
-    
-    startTimerHz(60);
-}
-
-SpectrumAnalyzer::~SpectrumAnalyzer()
-{
-    const auto& params = audioProcessor.getParameters();
-    for( auto param : params )
-    {
-        param->removeListener(this);
-    }
-}
-
-void SpectrumAnalyzer::timerCallback()
-{
-    if( shouldShowFFTAnalysis )
-    {
-        auto bounds = getLocalBounds();
-        auto fftBounds = getAnalysisArea(bounds).toFloat();
-        fftBounds.setBottom(bounds.getBottom());
-        
-        auto sampleRate = audioProcessor.getSampleRate();
-        
-        leftPathProducer.process(fftBounds,sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
-    }
-    
-    // If our parameters are changed, redraw the response curve:
-    if ( parametersChanged.compareAndSetBool(false, true) )
-    {
-    }
-    
-    repaint();
-}
-
-void SpectrumAnalyzer::paint (juce::Graphics& g)
-{
-    using namespace juce;
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (Colours::black);
-
-    auto bounds = drawModuleBackground(g, getLocalBounds());
-    
-    drawBackgroundGrid(g, bounds);
-    
-    if( shouldShowFFTAnalysis )
-    {
-        drawFFTAnalysis(g, bounds);
-    }
-    
-    drawCrossovers(g, bounds);
-    drawTextLabels(g, bounds);
-}
-
-std::vector<float> SpectrumAnalyzer::getFrequencies()
-{
-    return std::vector<float>
-    {
-        20, /*30, 40,*/ 50, 100,
-        200, /*300, 400,*/ 500, 1000,
-        2000, /*3000, 4000,*/ 5000, 10000,
-        20000
-    };
-}
-
-std::vector<float> SpectrumAnalyzer::getGains()
-{
-//    return std::vector<float>
-//    {
-//        -24, -12, 0, 12, 24
-//    };
-    std::vector<float> values;
-    
-    auto increment = MAX_DECIBELS; //12dB steps
-    for( auto db = NEGATIVE_INFINITY; db <= MAX_DECIBELS; db += increment)
-    {
-        values.push_back(db);
-    }
-    return values;
-}
-
-std::vector<float> SpectrumAnalyzer::getXs(const std::vector<float> &freqs, float left, float width)
-{
-    std::vector<float> xs;
-    for( auto f : freqs )
-    {
-        auto normX = juce::mapFromLog10(f, MIN_FREQUENCY, MAX_FREQUENCY);
-        xs.push_back( left + width * normX );
-    }
-    
-    return xs;
-}
-
-void SpectrumAnalyzer::drawBackgroundGrid(juce::Graphics &g, juce::Rectangle<int> bounds)
-{
-    using namespace juce;
-    auto freqs = getFrequencies();
-    
-    auto renderArea = getAnalysisArea(bounds);
-    auto left = renderArea.getX();
-    auto right = renderArea.getRight();
-    auto top = renderArea.getY();
-    auto bottom = renderArea.getBottom();
-    auto width = renderArea.getWidth();
-    
-    auto xs = getXs(freqs, left, width);
-    
-    g.setColour(Colours::dimgrey);
-    for( auto x : xs )
-    {
-        g.drawVerticalLine(x, top, bottom);
-    }
-    
-    auto gain = getGains();
-    
-    for( auto gDb : gain )
-    {
-        auto y = jmap(gDb, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
-        
-        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::darkgrey );
-        g.drawHorizontalLine(y, left, right);
-    }
-}
-
-void SpectrumAnalyzer::drawTextLabels(juce::Graphics &g, juce::Rectangle<int> bounds)
-{
-    using namespace juce;
-    g.setColour(Colours::lightgrey);
-    const int fontHeight = 10;
-    g.setFont(fontHeight);
-    
-    auto renderArea = getAnalysisArea(bounds);
-    auto left = renderArea.getX();
-    
-    auto top = renderArea.getY();
-    auto bottom = renderArea.getBottom();
-    auto width = renderArea.getWidth();
-    
-    auto freqs = getFrequencies();
-    auto xs = getXs(freqs, left, width);
-    
-    for( int i = 0; i < freqs.size(); ++i )
-    {
-        auto f = freqs[i];
-        auto x = xs[i];
-
-        bool addK = false;
-        String str;
-        if( f > 999.f )
-        {
-            addK = true;
-            f /= 1000.f;
-        }
-
-        str << f;
-        if( addK )
-            str << "k";
-        str << "Hz";
-        
-        auto textWidth = g.getCurrentFont().getStringWidth(str);
-
-        Rectangle<int> r;
-
-        r.setSize(textWidth, fontHeight);
-        r.setCentre(x, 0);
-        //r.setY(1);
-        r.setY(bounds.getY());
-        
-        g.drawFittedText(str, r, juce::Justification::centred, 1);
-    }
-    
-    auto gain = getGains();
-
-    for( auto gDb : gain )
-    {
-        auto y = jmap(gDb, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
-        
-        String str;
-        if( gDb > 0 )
-            str << "+";
-        str << gDb;
-        
-        auto textWidth = g.getCurrentFont().getStringWidth(str);
-        
-        Rectangle<int> r;
-        r.setSize(textWidth, fontHeight);
-//        r.setX(getWidth() - textWidth);
-        r.setX(bounds.getRight() - textWidth);
-        r.setCentre(r.getCentreX(), y);
-        
-        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::lightgrey );
-        
-        g.drawFittedText(str, r, juce::Justification::centredLeft, 1);
-        
-//        str.clear();
-//        str << (gDb - 24.f);
-
-//        r.setX(1);
-        r.setX(bounds.getX() + 1);
-//        textWidth = g.getCurrentFont().getStringWidth(str);
-//        r.setSize(textWidth, fontHeight);
-//        g.setColour(Colours::lightgrey);
-        g.drawFittedText(str, r, juce::Justification::centredLeft, 1);
-    }
-}
-
-void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics &g, juce::Rectangle<int> bounds)
-{
-    using namespace juce;
-    
-    auto responseArea = getAnalysisArea(bounds);
-    
-    juce::Graphics::ScopedSaveState sss(g);
-    g.reduceClipRegion(responseArea);
-    
-    auto leftChannelFFTPath = leftPathProducer.getPath();
-    leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
-
-    g.setColour(Colour(97u, 18u, 167u)); //purple-
-    g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
-
-    auto rightChannelFFTPath = rightPathProducer.getPath();
-    rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
-
-    g.setColour(Colour(215u, 201u, 134u));
-    g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
-}
-
-void SpectrumAnalyzer::drawCrossovers(juce::Graphics &g, juce::Rectangle<int> bounds)
-{
-    using namespace juce;
-    
-    bounds = getAnalysisArea(bounds);
-    
-    const auto top = bounds.getY();
-    const auto bottom = bounds.getBottom();
-    
-    const auto left = bounds.getX();
-    const auto right = bounds.getRight();
-    
-    //Map and draw the frequency crossover lines
-    
-    auto mapX = [left, width = bounds.getWidth()](float frequency)
-    {
-        auto normX = juce::mapFromLog10(frequency, MIN_FREQUENCY, MAX_FREQUENCY);
-        return left + width * normX;
-    };
-    
-    auto lowMidX = mapX(lowMidXoverParam->get());
-    g.setColour(Colours::orange);
-    g.drawVerticalLine(lowMidX, top, bottom);
-    
-    auto midHighX = mapX(midHighXoverParam->get());
-    g.drawVerticalLine(midHighX, top, bottom);
-    
-    
-    //Map and draw the threshold lines
-    
-    auto mapY = [bottom, top](auto db)
-    {
-        return jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
-    };
-    
-    g.setColour(Colours::yellow);
-    g.drawHorizontalLine(mapY(lowThresholdParam->get()), left, lowMidX);
-    g.drawHorizontalLine(mapY(midThresholdParam->get()), lowMidX, midHighX);
-    g.drawHorizontalLine(mapY(highThresholdParam->get()), midHighX, right);
-    
-    //Map and draw gain reduction
-    
-    auto zeroDb = mapY(0.f);
-    g.setColour(Colours::limegreen.withAlpha(0.3f));
-    
-    g.fillRect(Rectangle<float>::leftTopRightBottom(left, zeroDb, lowMidX, mapY(lowBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(lowMidX, zeroDb, midHighX, mapY(midBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(midHighX, zeroDb, right, mapY(highBandGR)));
-}
-
-void SpectrumAnalyzer::update(const std::vector<float>& values)
-{
-    jassert( values.size() == 6 );
-    enum
-    {
-        LowBandIn,
-        LowBandOut,
-        MidBandIn,
-        MidBandOut,
-        HighBandIn,
-        HighBandOut
-    };
-    
-    lowBandGR = values[LowBandOut] - values[LowBandIn];
-    midBandGR = values[MidBandOut] - values[MidBandIn];
-    highBandGR = values[HighBandOut] - values[HighBandIn];
-}
-
-void SpectrumAnalyzer::resized()
-{
-    using namespace juce;
-    
-    auto bounds = getLocalBounds();
-    auto fftBounds = getAnalysisArea(bounds).toFloat();
-    
-    auto negInf = jmap(bounds.toFloat().getBottom(),
-                            fftBounds.getBottom(),
-                            fftBounds.getY(),
-                            NEGATIVE_INFINITY,
-                            MAX_DECIBELS);
-    
-//    DBG("negative infinity: " << negInf);
-//    DBG("local bounds bottom: " << getLocalBounds().toFloat().getBottom());
-//    DBG("fft bottom: " << fftBounds.getBottom());
-//    DBG("fft top: " << fftBounds.getY());
-    leftPathProducer.updateNegativeInfinity(negInf);
-    rightPathProducer.updateNegativeInfinity(negInf);
-}
-
-void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
-{
-    parametersChanged.set(true);
-}
-
-juce::Rectangle<int> SpectrumAnalyzer::getRenderArea(juce::Rectangle<int> bounds)
-{
-    //auto bounds = getLocalBounds();
-    
-    bounds.removeFromTop(12);
-    bounds.removeFromBottom(2);
-    bounds.removeFromLeft(20);
-    bounds.removeFromRight(20);
-    
-    return bounds;
-}
-
-juce::Rectangle<int> SpectrumAnalyzer::getAnalysisArea(juce::Rectangle<int> bounds)
-{
-    bounds = getRenderArea(bounds);
-    bounds.removeFromTop(4);
-    bounds.removeFromBottom(4);
-    return bounds;
-};
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 29 Mar 2024 7:29:16pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+#include "../Utilities.h"
+#include "../DSP/Params.h"
+
+SpectrumAnalyzer::SpectrumAnalyzer(SimpleMBCompAudioProcessor& p) :
+audioProcessor(p),
+prePathProducer(audioProcessor.leftChannelFifo, audioProcessor.rightChannelFifo, binToPixelMap),
+postPathProducer(audioProcessor.postLeftChannelFifo, audioProcessor.postRightChannelFifo, binToPixelMap)
+{
+    using namespace Params;
+    
+    const auto& paramNames = GetParams();
+    
+    auto floatHelper = [&apvts = audioProcessor.apvts, &paramNames](auto& param, const auto& paramName)
+    {
+        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramNames.at(paramName)));
+        jassert(param != nullptr);
+    };
+    
+    floatHelper(lowMidXoverParam, Names::Low_Mid_Crossover_Freq);
+    floatHelper(midHighXoverParam, Names::Mid_High_Crossover_Freq);
+    
+    floatHelper(lowThresholdParam, Names::Threshold_Low_Band);
+    floatHelper(midThresholdParam, Names::Threshold_Mid_Band);
+    floatHelper(highThresholdParam, Names::Threshold_High_Band);
+    
+    auto choiceHelper = [&apvts = audioProcessor.apvts, &paramNames](auto& param, const auto& paramName)
+    {
+        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(paramNames.at(paramName)));
+        jassert(param != nullptr);
+    };
+    
+    choiceHelper(lowRatioParam, Names::Ratio_Low_Band);
+    choiceHelper(midRatioParam, Names::Ratio_Mid_Band);
+    choiceHelper(highRatioParam, Names::Ratio_High_Band);
+    
+    //the crossovers are the only ones the band shading needs to know about
+    crossoverParameterBits = parameterSubscription.subscribe(*lowMidXoverParam)
+                           | parameterSubscription.subscribe(*midHighXoverParam);
+    
+    for( auto* param : std::initializer_list<juce::AudioProcessorParameter*>
+         {
+             lowThresholdParam, midThresholdParam, highThresholdParam,
+             lowRatioParam, midRatioParam, highRatioParam
+         } )
+    {
+        parameterSubscription.subscribe(*param);
+    }
+    
+    parameterSubscription.startListening();
+    
+    postPathProducer.setCrossoverFrequencies(lowMidXoverParam->get(), midHighXoverParam->get());
+    postPathProducer.setStereoImageAnalysis(&stereoImageAnalysis);
+    
+    //the FFT engines and the analysis thread are started by the first processFrame(),
+    //i.e. once the analyzer is actually on screen, so opening the editor doesn't wait for them
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    analysisThread.stopThread(1000);
+}
+
+void SpectrumAnalyzer::processFrame()
+{
+    //The analysis thread runs even while the spectrum is hidden, since the stereo image
+    //is analysed from the same blocks. It just skips the FFT work then.
+    if( analysisRunsOnThread && ! analysisThread.isThreadRunning() )
+        analysisThread.startThread();
+    
+    if( shouldShowFFTAnalysis )
+    {
+        //the first call posts the engines to the backgroundPool
+        updateFFTOrder();
+        
+        //pick up whatever the analysis thread finished since the last frame,
+        //then start it on the next one
+        auto preHasNewPaths = prePathProducer.pullPaths();
+        auto postHasNewPaths = postPathProducer.pullPaths();
+        
+        auto hasNewColumns = postPathProducer.pullSpectrogramColumns(spectrogram);
+        
+        //nothing new arrives while the audio is silent or stopped, so this goes idle
+        //(the spectrogram keeps scrolling through silence, but stops with the audio)
+        auto hasNewFrame = displayMode == DisplayMode::spectrogram ?
+                           hasNewColumns :
+                           preHasNewPaths || postHasNewPaths;
+        
+        if( hasNewFrame )
+            repaint(analysisArea);
+    }
+    
+    analysisThread.notify();
+    
+    // If our parameters are changed, the crossover and threshold lines may have moved.
+    // Gain reduction changes all the time, so it is checked every frame.
+    // Either way, only the regions that actually moved are repainted.
+    auto newOverlay = drawnOverlay;
+    
+    auto changedParameters = parameterSubscription.takeChanges();
+    
+    if( changedParameters != 0 )
+    {
+        updateParameterOverlay(newOverlay);
+        
+        if( (changedParameters & crossoverParameterBits) != 0 )
+            postPathProducer.setCrossoverFrequencies(lowMidXoverParam->get(), midHighXoverParam->get());
+        
+        //the overlay is rebuilt in the background, and only if what it shows actually changed
+        updateResponseOverlay();
+    }
+    
+    if( responseOverlay.pullPaths() && displayMode != DisplayMode::spectrogram )
+        repaint(analysisArea);
+    
+    if( staticLayerPending )
+        pullRenderedStaticLayer();
+    
+    updateGainReductionOverlay(newOverlay);
+    
+    repaintChangedOverlays(newOverlay);
+}
+
+//these must match the mappings in drawCrossovers()
+int SpectrumAnalyzer::mapFrequencyToX(float frequency) const
+{
+    auto normX = juce::mapFromLog10(frequency, MIN_FREQUENCY, MAX_FREQUENCY);
+    return juce::roundToInt(analysisArea.getX() + analysisArea.getWidth() * normX);
+}
+
+void SpectrumAnalyzer::updateResponseOverlay()
+{
+    //the ratio choices are named after their values, the same way CompressorBand reads them
+    auto getRatio = [](const juce::AudioParameterChoice* param)
+    {
+        return param->getCurrentChoiceName().getFloatValue();
+    };
+    
+    ResponseOverlay::Settings settings;
+    settings.lowMidFrequency = lowMidXoverParam->get();
+    settings.midHighFrequency = midHighXoverParam->get();
+    settings.thresholds = { lowThresholdParam->get(), midThresholdParam->get(), highThresholdParam->get() };
+    settings.ratios = { getRatio(lowRatioParam), getRatio(midRatioParam), getRatio(highRatioParam) };
+    settings.area = analysisArea.toFloat();
+    
+    responseOverlay.update(settings, backgroundPool);
+}
+
+int SpectrumAnalyzer::mapDecibelsToY(float db) const
+{
+    return juce::roundToInt(juce::jmap(db,
+                                       NEGATIVE_INFINITY,
+                                       MAX_DECIBELS,
+                                       float(analysisArea.getBottom()),
+                                       float(analysisArea.getY())));
+}
+
+void SpectrumAnalyzer::updateParameterOverlay(OverlayGeometry& geometry) const
+{
+    geometry.lowMidX = mapFrequencyToX(lowMidXoverParam->get());
+    geometry.midHighX = mapFrequencyToX(midHighXoverParam->get());
+    
+    geometry.thresholdYs =
+    {
+        mapDecibelsToY(lowThresholdParam->get()),
+        mapDecibelsToY(midThresholdParam->get()),
+        mapDecibelsToY(highThresholdParam->get())
+    };
+}
+
+void SpectrumAnalyzer::updateGainReductionOverlay(OverlayGeometry& geometry) const
+{
+    geometry.gainReductionYs =
+    {
+        mapDecibelsToY(lowBandGR),
+        mapDecibelsToY(midBandGR),
+        mapDecibelsToY(highBandGR)
+    };
+}
+
+void SpectrumAnalyzer::repaintChangedOverlays(const OverlayGeometry& newOverlay)
+{
+    using namespace juce;
+    
+    auto oldOverlay = drawnOverlay;
+    drawnOverlay = newOverlay;
+    
+    //moving a crossover resizes every band, so just repaint the lot
+    if( oldOverlay.lowMidX != newOverlay.lowMidX || oldOverlay.midHighX != newOverlay.midHighX )
+    {
+        repaint(analysisArea);
+        return;
+    }
+    
+    //the spectrogram only shows the crossovers
+    if( displayMode == DisplayMode::spectrogram )
+        return;
+    
+    const std::array<int, 4> bandEdges
+    {
+        analysisArea.getX(),
+        newOverlay.lowMidX,
+        newOverlay.midHighX,
+        analysisArea.getRight()
+    };
+    
+    //the strip of a band between two y positions, with a pixel of slack for antialiasing
+    auto bandStrip = [&bandEdges](size_t band, int y1, int y2)
+    {
+        return Rectangle<int>::leftTopRightBottom(bandEdges[band] - 1,
+                                                  jmin(y1, y2) - 1,
+                                                  bandEdges[band + 1] + 1,
+                                                  jmax(y1, y2) + 2);
+    };
+    
+    const auto zeroDbY = mapDecibelsToY(0.f);
+    
+    for( size_t band = 0; band < newOverlay.thresholdYs.size(); ++band )
+    {
+        auto oldThresholdY = oldOverlay.thresholdYs[band];
+        auto newThresholdY = newOverlay.thresholdYs[band];
+        
+        if( oldThresholdY != newThresholdY )
+        {
+            repaint(bandStrip(band, oldThresholdY, oldThresholdY));
+            repaint(bandStrip(band, newThresholdY, newThresholdY));
+        }
+        
+        //the GR rect always starts at 0dB, so only the part between its old and new ends changed
+        auto oldGainReductionY = oldOverlay.gainReductionYs[band];
+        auto newGainReductionY = newOverlay.gainReductionYs[band];
+        
+        if( oldGainReductionY != newGainReductionY )
+        {
+            auto changedStrip = bandStrip(band, oldGainReductionY, newGainReductionY);
+            
+            //crossing 0dB flips which side of the line the rect is on
+            if( (oldGainReductionY - zeroDbY) * (newGainReductionY - zeroDbY) < 0 )
+                changedStrip = changedStrip.getUnion(bandStrip(band, zeroDbY, zeroDbY));
+            
+            repaint(changedStrip);
+        }
+    }
+}
+
+void SpectrumAnalyzer::AnalysisThread::run()
+{
+    while( ! threadShouldExit() )
+    {
+        wait(-1);
+        
+        if( threadShouldExit() )
+            break;
+        
+        analyzer.runAnalysis();
+    }
+}
+
+void SpectrumAnalyzer::runAnalysis()
+{
+    juce::Rectangle<float> fftBounds;
+    {
+        const juce::SpinLock::ScopedLockType lock(analysisBoundsLock);
+        fftBounds = analysisBounds;
+    }
+    
+    auto sampleRate = audioProcessor.getSampleRate();
+    
+    //both taps run through the same thread, window, FFT plan and bin -> pixel table,
+    //so the second spectrum only costs its FFTs
+    const bool produceSpectrum = shouldShowFFTAnalysis;
+    prePathProducer.process(fftBounds, sampleRate, produceSpectrum);
+    postPathProducer.process(fftBounds, sampleRate, produceSpectrum);
+}
+
+void SpectrumAnalyzer::waitForBackgroundWork()
+{
+    while( backgroundPool.getNumJobs() > 0 )
+        juce::Thread::sleep(1);
+}
+
+void SpectrumAnalyzer::paint (juce::Graphics& g)
+{
+    using namespace juce;
+    
+    //Render at the physical resolution of whatever we're being drawn on,
+    //so the cached grid and labels are as sharp as drawing them directly
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    auto localBounds = getLocalBounds();
+    
+    if( ! staticLayer.matches(localBounds, scale, displayMode) )
+    {
+        //a stretched layer is fine while resizing, or for the frame or two until the real one arrives
+        auto canStretch = (liveResize || staticLayerPending)
+                        && staticLayer.image.isValid()
+                        && staticLayer.scale == scale
+                        && staticLayer.mode == displayMode;
+        
+        if( ! canStretch )
+        {
+            staticLayer = renderStaticLayer(localBounds, scale, displayMode);
+            staticLayerPending = false;
+        }
+    }
+    
+    // (Our component is opaque, and the static layer covers all of it)
+    g.drawImage(staticLayer.image, localBounds.toFloat());
+
+    //everything else is drawn inside the module background, which is inset by 3px
+    auto bounds = localBounds.reduced(3);
+    
+    if( displayMode == DisplayMode::spectrogram )
+    {
+        if( shouldShowFFTAnalysis )
+        {
+            spectrogram.draw(g, getAnalysisArea(bounds));
+        }
+        
+        drawSpectrogramCrossovers(g, bounds);
+        return;
+    }
+    
+    if( shouldShowFFTAnalysis )
+    {
+        if( displayMode == DisplayMode::bands )
+            drawBandShading(g, bounds);
+        
+        drawFFTAnalysis(g, bounds);
+    }
+    
+    drawCrossovers(g, bounds);
+}
+
+SpectrumAnalyzer::StaticLayer SpectrumAnalyzer::renderStaticLayer(juce::Rectangle<int> bounds, float scale, DisplayMode mode)
+{
+    using namespace juce;
+    
+    StaticLayer layer;
+    layer.bounds = bounds;
+    layer.scale = scale;
+    layer.mode = mode;
+    layer.image = Image(Image::RGB,
+                        jmax(1, roundToInt(bounds.getWidth() * scale)),
+                        jmax(1, roundToInt(bounds.getHeight() * scale)),
+                        false);
+    
+    Graphics g(layer.image);
+    g.addTransform(AffineTransform::scale(scale));
+    
+    g.fillAll (Colours::black);
+
+    auto contentBounds = drawModuleBackground(g, bounds);
+    
+    if( mode == DisplayMode::spectrogram )
+    {
+        drawSpectrogramLabels(g, contentBounds);
+    }
+    else
+    {
+        drawBackgroundGrid(g, contentBounds);
+        drawTextLabels(g, contentBounds);
+    }
+    
+    return layer;
+}
+
+void SpectrumAnalyzer::pullRenderedStaticLayer()
+{
+    std::optional<StaticLayer> rendered;
+    {
+        const juce::SpinLock::ScopedLockType lock(renderedStaticLayerLock);
+        rendered.swap(renderedStaticLayer);
+    }
+    
+    if( ! rendered.has_value() )
+        return;
+    
+    //one that was overtaken by another resize or a display mode change is just dropped,
+    //paint() renders the right one itself
+    if( rendered->matches(getLocalBounds(), staticLayer.scale, displayMode) )
+        staticLayer = std::move(*rendered);
+    
+    staticLayerPending = false;
+    repaint();
+}
+
+std::vector<float> SpectrumAnalyzer::getFrequencies()
+{
+    return std::vector<float>
+    {
+        20, /*30, 40,*/ 50, 100,
+        200, /*300, 400,*/ 500, 1000,
+        2000, /*3000, 4000,*/ 5000, 10000,
+        20000
+    };
+}
+
+std::vector<float> SpectrumAnalyzer::getGains()
+{
+//    return std::vector<float>
+//    {
+//        -24, -12, 0, 12, 24
+//    };
+    std::vector<float> values;
+    
+    auto increment = MAX_DECIBELS; //12dB steps
+    for( auto db = NEGATIVE_INFINITY; db <= MAX_DECIBELS; db += increment)
+    {
+        values.push_back(db);
+    }
+    return values;
+}
+
+std::vector<float> SpectrumAnalyzer::getXs(const std::vector<float> &freqs, float left, float width)
+{
+    std::vector<float> xs;
+    for( auto f : freqs )
+    {
+        auto normX = juce::mapFromLog10(f, MIN_FREQUENCY, MAX_FREQUENCY);
+        xs.push_back( left + width * normX );
+    }
+    
+    return xs;
+}
+
+void SpectrumAnalyzer::drawBackgroundGrid(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    using namespace juce;
+    auto freqs = getFrequencies();
+    
+    auto renderArea = getAnalysisArea(bounds);
+    auto left = renderArea.getX();
+    auto right = renderArea.getRight();
+    auto top = renderArea.getY();
+    auto bottom = renderArea.getBottom();
+    auto width = renderArea.getWidth();
+    
+    auto xs = getXs(freqs, left, width);
+    
+    g.setColour(Colours::dimgrey);
+    for( auto x : xs )
+    {
+        g.drawVerticalLine(x, top, bottom);
+    }
+    
+    auto gain = getGains();
+    
+    for( auto gDb : gain )
+    {
+        auto y = jmap(gDb, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
+        
+        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::darkgrey );
+        g.drawHorizontalLine(y, left, right);
+    }
+}
+
+void SpectrumAnalyzer::drawTextLabels(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    using namespace juce;
+    g.setColour(Colours::lightgrey);
+    const int fontHeight = 10;
+    g.setFont(fontHeight);
+    
+    auto renderArea = getAnalysisArea(bounds);
+    auto left = renderArea.getX();
+    
+    auto top = renderArea.getY();
+    auto bottom = renderArea.getBottom();
+    auto width = renderArea.getWidth();
+    
+    auto freqs = getFrequencies();
+    auto xs = getXs(freqs, left, width);
+    
+    for( int i = 0; i < freqs.size(); ++i )
+    {
+        auto f = freqs[i];
+        auto x = xs[i];
+
+        bool addK = false;
+        String str;
+        if( f > 999.f )
+        {
+            addK = true;
+            f /= 1000.f;
+        }
+
+        str << f;
+        if( addK )
+            str << "k";
+        str << "Hz";
+        
+        auto textWidth = g.getCurrentFont().getStringWidth(str);
+
+        Rectangle<int> r;
+
+        r.setSize(textWidth, fontHeight);
+        r.setCentre(x, 0);
+        //r.setY(1);
+        r.setY(bounds.getY());
+        
+        g.drawFittedText(str, r, juce::Justification::centred, 1);
+    }
+    
+    auto gain = getGains();
+
+    for( auto gDb : gain )
+    {
+        auto y = jmap(gDb, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
+        
+        String str;
+        if( gDb > 0 )
+            str << "+";
+        str << gDb;
+        
+        auto textWidth = g.getCurrentFont().getStringWidth(str);
+        
+        Rectangle<int> r;
+        r.setSize(textWidth, fontHeight);
+//        r.setX(getWidth() - textWidth);
+        r.setX(bounds.getRight() - textWidth);
+        r.setCentre(r.getCentreX(), y);
+        
+        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::lightgrey );
+        
+        g.drawFittedText(str, r, juce::Justification::centredLeft, 1);
+        
+//        str.clear();
+//        str << (gDb - 24.f);
+
+//        r.setX(1);
+        r.setX(bounds.getX() + 1);
+//        textWidth = g.getCurrentFont().getStringWidth(str);
+//        r.setSize(textWidth, fontHeight);
+//        g.setColour(Colours::lightgrey);
+        g.drawFittedText(str, r, juce::Justification::centredLeft, 1);
+    }
+}
+
+void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    using namespace juce;
+    
+    auto responseArea = getAnalysisArea(bounds);
+    
+    juce::Graphics::ScopedSaveState sss(g);
+    g.reduceClipRegion(responseArea);
+    
+    //the paths are generated in component coordinates, so they can be stroked without a copy
+    const auto leftColour = Colour(97u, 18u, 167u); //purple-
+    const auto rightColour = Colour(215u, 201u, 134u);
+    
+    //the input spectrum goes at the bottom, faded, so the output can be compared against it
+    g.setColour(leftColour.withAlpha(0.35f));
+    g.strokePath(prePathProducer.getPath(Channel::Left), PathStrokeType(1.f));
+    
+    g.setColour(rightColour.withAlpha(0.35f));
+    g.strokePath(prePathProducer.getPath(Channel::Right), PathStrokeType(1.f));
+    
+    //then the output peak hold traces
+    g.setColour(leftColour.withAlpha(0.5f));
+    g.strokePath(postPathProducer.getPeakPath(Channel::Left), PathStrokeType(1.f));
+    
+    g.setColour(rightColour.withAlpha(0.5f));
+    g.strokePath(postPathProducer.getPeakPath(Channel::Right), PathStrokeType(1.f));
+    
+    //and the output spectrum on top
+    const auto& leftChannelFFTPath = postPathProducer.getPath(Channel::Left);
+
+    g.setColour(leftColour);
+    g.strokePath(leftChannelFFTPath, PathStrokeType(1.5f));
+
+    const auto& rightChannelFFTPath = postPathProducer.getPath(Channel::Right);
+
+    g.setColour(rightColour);
+    g.strokePath(rightChannelFFTPath, PathStrokeType(1.5f));
+}
+
+void SpectrumAnalyzer::drawBandShading(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    using namespace juce;
+    
+    juce::Graphics::ScopedSaveState sss(g);
+    g.reduceClipRegion(getAnalysisArea(bounds));
+    
+    //under the traces, and see-through, so the overlap around each crossover shows up
+    const std::array<Colour, CrossoverResponses::numBands> bandColours
+    {
+        Colours::royalblue,
+        Colours::seagreen,
+        Colours::indianred
+    };
+    
+    for( int band = 0; band < CrossoverResponses::numBands; ++band )
+    {
+        g.setColour(bandColours[band].withAlpha(0.35f));
+        g.fillPath(postPathProducer.getBandPath(band));
+    }
+}
+
+void SpectrumAnalyzer::drawCrossovers(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    using namespace juce;
+    
+    bounds = getAnalysisArea(bounds);
+    
+    const auto top = bounds.getY();
+    const auto bottom = bounds.getBottom();
+    
+    const auto left = bounds.getX();
+    const auto right = bounds.getRight();
+    
+    //Map and draw the frequency crossover lines
+    
+    auto mapX = [left, width = bounds.getWidth()](float frequency)
+    {
+        auto normX = juce::mapFromLog10(frequency, MIN_FREQUENCY, MAX_FREQUENCY);
+        return left + width * normX;
+    };
+    
+    //the band responses and compression curves, if they have been built yet
+    if( auto* overlayPaths = responseOverlay.getPaths() )
+    {
+        juce::Graphics::ScopedSaveState sss(g);
+        g.reduceClipRegion(bounds);
+        
+        //they are only rebuilt once a live resize is over, until then they're stretched into place
+        auto transform = overlayPaths->area.isEmpty() ?
+                         AffineTransform() :
+                         RectanglePlacement(RectanglePlacement::stretchToFit).getTransformToFit(overlayPaths->area, bounds.toFloat());
+        
+        g.setColour(Colours::orange.withAlpha(0.5f));
+        for( const auto& path : overlayPaths->bandResponses )
+            g.strokePath(path, PathStrokeType(1.f), transform);
+        
+        g.setColour(Colours::yellow.withAlpha(0.4f));
+        for( const auto& path : overlayPaths->transferCurves )
+            g.strokePath(path, PathStrokeType(1.f), transform);
+    }
+    
+    auto lowMidX = mapX(lowMidXoverParam->get());
+    g.setColour(Colours::orange);
+    g.drawVerticalLine(lowMidX, top, bottom);
+    
+    auto midHighX = mapX(midHighXoverParam->get());
+    g.drawVerticalLine(midHighX, top, bottom);
+    
+    
+    //Map and draw the threshold lines
+    
+    auto mapY = [bottom, top](auto db)
+    {
+        return jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
+    };
+    
+    g.setColour(Colours::yellow);
+    g.drawHorizontalLine(mapY(lowThresholdParam->get()), left, lowMidX);
+    g.drawHorizontalLine(mapY(midThresholdParam->get()), lowMidX, midHighX);
+    g.drawHorizontalLine(mapY(highThresholdParam->get()), midHighX, right);
+    
+    //Map and draw gain reduction
+    
+    auto zeroDb = mapY(0.f);
+    g.setColour(Colours::limegreen.withAlpha(0.3f));
+    
+    g.fillRect(Rectangle<float>::leftTopRightBottom(left, zeroDb, lowMidX, mapY(lowBandGR)));
+    g.fillRect(Rectangle<float>::leftTopRightBottom(lowMidX, zeroDb, midHighX, mapY(midBandGR)));
+    g.fillRect(Rectangle<float>::leftTopRightBottom(midHighX, zeroDb, right, mapY(highBandGR)));
+}
+
+int SpectrumAnalyzer::mapFrequencyToSpectrogramY(float frequency, juce::Rectangle<int> area) const
+{
+    //the same log mapping as the spectrogram's rows, lowest frequency at the bottom
+    auto normY = juce::mapFromLog10(frequency, MIN_FREQUENCY, MAX_FREQUENCY);
+    return juce::roundToInt(area.getBottom() - area.getHeight() * normY);
+}
+
+void SpectrumAnalyzer::drawSpectrogramCrossovers(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    using namespace juce;
+    
+    bounds = getAnalysisArea(bounds);
+    
+    //frequency runs up the spectrogram, so the crossovers are horizontal lines
+    g.setColour(Colours::orange);
+    g.drawHorizontalLine(mapFrequencyToSpectrogramY(lowMidXoverParam->get(), bounds), bounds.getX(), bounds.getRight());
+    g.drawHorizontalLine(mapFrequencyToSpectrogramY(midHighXoverParam->get(), bounds), bounds.getX(), bounds.getRight());
+}
+
+void SpectrumAnalyzer::drawSpectrogramLabels(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    using namespace juce;
+    g.setColour(Colours::lightgrey);
+    const int fontHeight = 10;
+    g.setFont(fontHeight);
+    
+    auto renderArea = getAnalysisArea(bounds);
+    
+    //the frequencies go down both sides, where the gain labels normally are.
+    //There's only 20px there, so the "Hz" is left off.
+    for( auto f : getFrequencies() )
+    {
+        auto y = mapFrequencyToSpectrogramY(f, renderArea);
+        
+        String str;
+        if( f > 999.f )
+            str << (f / 1000.f) << "k";
+        else
+            str << f;
+        
+        auto textWidth = g.getCurrentFont().getStringWidth(str);
+        
+        Rectangle<int> r;
+        r.setSize(textWidth, fontHeight);
+        r.setCentre(r.getCentreX(), y);
+        
+        r.setX(bounds.getRight() - textWidth);
+        g.drawFittedText(str, r, juce::Justification::centredLeft, 1);
+        
+        r.setX(bounds.getX() + 1);
+        g.drawFittedText(str, r, juce::Justification::centredLeft, 1);
+    }
+}
+
+void SpectrumAnalyzer::setDisplayMode(DisplayMode newMode)
+{
+    if( newMode == displayMode )
+        return;
+    
+    displayMode = newMode;
+    postPathProducer.setSpectrogramEnabled(displayMode == DisplayMode::spectrogram);
+    postPathProducer.setBandShading(displayMode == DisplayMode::bands);
+    
+    //the labels are different, so the static layer has to be redrawn too (paint() does that)
+    repaint();
+}
+
+void SpectrumAnalyzer::update(const MeterSnapshot& snapshot)
+{
+    //the difference of the 300ms integrated levels, so the bars move the same whatever the host's block size
+    auto levelDifference = [](const BandMeterReading& band)
+    {
+        return band.outputBallistics.vuDb - band.inputBallistics.vuDb;
+    };
+    
+    lowBandGR = levelDifference(snapshot.bands[0]);
+    midBandGR = levelDifference(snapshot.bands[1]);
+    highBandGR = levelDifference(snapshot.bands[2]);
+}
+
+void SpectrumAnalyzer::setFFTOrder(FFTOrder newOrder)
+{
+    userFFTOrder = newOrder;
+    updateFFTOrder();
+}
+
+void SpectrumAnalyzer::setFFTOrderFollowsSampleRate()
+{
+    userFFTOrder.reset();
+    updateFFTOrder();
+}
+
+void SpectrumAnalyzer::updateFFTOrder()
+{
+    //The sample rate can change while the editor is open, so this is checked every frame
+    auto newOrder = userFFTOrder.value_or(getDefaultFFTOrder(audioProcessor.getSampleRate()));
+    
+    if( newOrder == requestedFFTOrder )
+        return;
+    
+    requestedFFTOrder = newOrder;
+    
+    //one plan (FFT + window) is shared by both taps, and with every other analyzer in the process
+    backgroundPool.addJob([this, newOrder]()
+    {
+        auto plan = FFTPlan::getShared(newOrder);
+        
+        prePathProducer.postPlan(plan);
+        postPathProducer.postPlan(plan);
+    });
+}
+
+void SpectrumAnalyzer::resized()
+{
+    using namespace juce;
+    
+    //paint() draws inside the module background, which is inset by 3px.
+    //The paths are generated in the same area as the grid and overlays, so they line up with them.
+    auto bounds = getLocalBounds().reduced(3);
+    
+    analysisArea = getAnalysisArea(bounds);
+    auto fftBounds = analysisArea.toFloat();
+    
+    updateParameterOverlay(drawnOverlay);
+    updateGainReductionOverlay(drawnOverlay);
+    
+    //The static layer no longer matches, so paint() renders a new one, and the histories start over at the new size.
+    //During a live resize all of that waits for setLiveResize(false).
+    if( ! liveResize )
+    {
+        staticLayerPending = false;
+        updateResponseOverlay();
+        resizeHistories();
+    }
+    
+    auto negInf = jmap(bounds.toFloat().getBottom(),
+                            fftBounds.getBottom(),
+                            fftBounds.getY(),
+                            NEGATIVE_INFINITY,
+                            MAX_DECIBELS);
+    
+//    DBG("negative infinity: " << negInf);
+//    DBG("local bounds bottom: " << getLocalBounds().toFloat().getBottom());
+//    DBG("fft bottom: " << fftBounds.getBottom());
+//    DBG("fft top: " << fftBounds.getY());
+    prePathProducer.updateNegativeInfinity(negInf);
+    postPathProducer.updateNegativeInfinity(negInf);
+    
+    fftBounds.setBottom(bounds.toFloat().getBottom());
+    
+    const juce::SpinLock::ScopedLockType lock(analysisBoundsLock);
+    analysisBounds = fftBounds;
+}
+
+void SpectrumAnalyzer::setLiveResize(bool isLive)
+{
+    if( isLive == liveResize )
+        return;
+    
+    liveResize = isLive;
+    
+    if( liveResize )
+        return;
+    
+    updateResponseOverlay();
+    resizeHistories();
+    
+    //the layer is only rendered in the background if it has been painted at some scale already
+    if( staticLayer.scale <= 0.f )
+        return;
+    
+    staticLayerPending = true;
+    
+    backgroundPool.addJob([this, bounds = getLocalBounds(), scale = staticLayer.scale, mode = displayMode]()
+    {
+        auto layer = renderStaticLayer(bounds, scale, mode);
+        
+        const juce::SpinLock::ScopedLockType lock(renderedStaticLayerLock);
+        renderedStaticLayer = std::move(layer);
+    });
+}
+
+void SpectrumAnalyzer::resizeHistories()
+{
+    //one row per pixel, one column of history per pixel
+    spectrogram.setSize(analysisArea.getWidth(), analysisArea.getHeight());
+    postPathProducer.setSpectrogramSize(analysisArea.getHeight(), analysisArea.getWidth());
+}
+
+juce::Rectangle<int> SpectrumAnalyzer::getRenderArea(juce::Rectangle<int> bounds)
+{
+    //auto bounds = getLocalBounds();
+    
+    bounds.removeFromTop(12);
+    bounds.removeFromBottom(2);
+    bounds.removeFromLeft(20);
+    bounds.removeFromRight(20);
+    
+    return bounds;
+}
+
+juce::Rectangle<int> SpectrumAnalyzer::getAnalysisArea(juce::Rectangle<int> bounds)
+{
+    bounds = getRenderArea(bounds);
+    bounds.removeFromTop(4);
+    bounds.removeFromBottom(4);
+    return bounds;
+};
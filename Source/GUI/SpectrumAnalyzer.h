@@ -1,73 +1,254 @@
-/*
-  ==============================================================================
-
-    SpectrumAnalyzer.h
-    Created: 29 Mar 2024 7:29:16pm
-    Author:  Joseph Skonie
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "PathProducer.h"
-#include "../PluginProcessor.h"
-
-
-struct SpectrumAnalyzer: juce::Component,
-juce::AudioProcessorParameter::Listener,
-juce::Timer
-{
-    SpectrumAnalyzer(SimpleMBCompAudioProcessor&);
-    ~SpectrumAnalyzer();
-    
-    void parameterValueChanged (int parameterIndex, float newValue) override;
-
-    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override { }
-    
-    void timerCallback() override;
-    
-    void paint(juce::Graphics& g) override;
-    void resized() override;
-    
-    void toggleAnalysisEnablement(bool enabled)
-    {
-        shouldShowFFTAnalysis = enabled;
-    }
-    
-    void update(const std::vector<float>& values);
-private:
-    SimpleMBCompAudioProcessor& audioProcessor;
-
-    bool shouldShowFFTAnalysis = true;
-
-    juce::Atomic<bool> parametersChanged { false };
-    
-    //void drawBackgroundGrid(juce::Graphics& g);
-    void drawBackgroundGrid(juce::Graphics& g, juce::Rectangle<int> bounds);
-    
-    void drawTextLabels(juce::Graphics& g, juce::Rectangle<int> bounds);
-    
-    void drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds);
-    
-    void drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bounds);
-    
-    juce::AudioParameterFloat* lowMidXoverParam { nullptr };
-    juce::AudioParameterFloat* midHighXoverParam { nullptr };
-    
-    juce::AudioParameterFloat* lowThresholdParam { nullptr };
-    juce::AudioParameterFloat* midThresholdParam { nullptr };
-    juce::AudioParameterFloat* highThresholdParam { nullptr };
-    
-    float lowBandGR { 0.f }, midBandGR { 0.f }, highBandGR { 0.f };
-    
-    std::vector<float> getFrequencies();
-    std::vector<float> getGains();
-    std::vector<float> getXs(const std::vector<float>& freqs, float left, float width);
-
-    juce::Rectangle<int> getRenderArea(juce::Rectangle<int> bounds);
-    
-    juce::Rectangle<int> getAnalysisArea(juce::Rectangle<int> bounds);
-    
-    PathProducer leftPathProducer, rightPathProducer;
-};
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 29 Mar 2024 7:29:16pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PathProducer.h"
+#include "ResponseOverlay.h"
+#include "ParameterSubscription.h"
+#include "../PluginProcessor.h"
+#include <optional>
+
+
+struct SpectrumAnalyzer: juce::Component
+{
+    SpectrumAnalyzer(SimpleMBCompAudioProcessor&);
+    ~SpectrumAnalyzer() override;
+    
+    /**
+     Called by the editor once per display refresh.
+     Picks up whatever the analysis thread finished and repaints only the parts
+     that changed: the spectrum when there is a new frame, and the crossover,
+     threshold and gain reduction overlays when they moved.
+     */
+    void processFrame();
+    
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    
+    void toggleAnalysisEnablement(bool enabled)
+    {
+        shouldShowFFTAnalysis = enabled;
+        repaint(analysisArea);
+    }
+    
+    //Takes the bands' gain reduction from the processor's latest meter snapshot
+    void update(const MeterSnapshot& snapshot);
+    
+    //Analyses both channels with a single complex FFT (on by default)
+    void setStereoPacking(bool shouldPack)
+    {
+        prePathProducer.setStereoPacking(shouldPack);
+        postPathProducer.setStereoPacking(shouldPack);
+    }
+    
+    //Locks the analyzer to a fixed FFT order
+    void setFFTOrder(FFTOrder newOrder);
+    
+    //Lets the analyzer pick the FFT order from the sample rate (the default)
+    void setFFTOrderFollowsSampleRate();
+    
+    //Analyses with small FFTs per octave instead of one big FFT, see MultiResolutionAnalyzer
+    void setMultiResolution(bool shouldUseMultiResolution)
+    {
+        prePathProducer.setMultiResolution(shouldUseMultiResolution);
+        postPathProducer.setMultiResolution(shouldUseMultiResolution);
+    }
+    
+    enum class DisplayMode
+    {
+        spectrum,
+        spectrogram,
+        bands
+    };
+    
+    //The spectrogram shows the output over the last 20 seconds, with frequency going up.
+    //'bands' is the spectrum, with the output shaded by how much of it each band carries.
+    void setDisplayMode(DisplayMode newMode);
+    
+    //Called by the editor when a resize gesture starts and once it has finished
+    void setLiveResize(bool isLive);
+    
+    /**
+     The analysis normally runs on the analyzer's own thread, which processFrame() starts and wakes.
+     With this off the thread is never started, and whoever drives the frames calls runAnalysis()
+     themselves, e.g. to render repeatable frames without a display. Set it before the first processFrame().
+     */
+    void setAnalysisRunsOnThread(bool shouldRunOnThread)
+    {
+        jassert( ! analysisThread.isThreadRunning() );
+        analysisRunsOnThread = shouldRunOnThread;
+    }
+    
+    //Analyses whatever both taps have collected, on the calling thread.
+    //The analysis thread runs it every frame, so only call it yourself after setAnalysisRunsOnThread(false).
+    void runAnalysis();
+    
+    //Blocks the calling thread until the backgroundPool has finished every job posted to it,
+    //i.e. the FFT engines, overlays and cached layers are all up to date
+    void waitForBackgroundWork();
+    
+    //The output's correlation and goniometer points, worked out on the analysis thread
+    //from the same blocks as the output spectrum. Keeps running while the spectrum is hidden.
+    StereoImageAnalysis& getStereoImageAnalysis() { return stereoImageAnalysis; }
+private:
+    SimpleMBCompAudioProcessor& audioProcessor;
+
+    //read by the analysis thread too
+    std::atomic<bool> shouldShowFFTAnalysis { true };
+
+    //void drawBackgroundGrid(juce::Graphics& g);
+    void drawBackgroundGrid(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    void drawTextLabels(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    void drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    void drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    void drawBandShading(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    void drawSpectrogramCrossovers(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    void drawSpectrogramLabels(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    int mapFrequencyToSpectrogramY(float frequency, juce::Rectangle<int> area) const;
+    
+    DisplayMode displayMode { DisplayMode::spectrum };
+    
+    //the history ring, written from the output tap's spectrogram columns
+    SpectrogramImage spectrogram;
+    
+    juce::AudioParameterFloat* lowMidXoverParam { nullptr };
+    juce::AudioParameterFloat* midHighXoverParam { nullptr };
+    
+    juce::AudioParameterFloat* lowThresholdParam { nullptr };
+    juce::AudioParameterFloat* midThresholdParam { nullptr };
+    juce::AudioParameterFloat* highThresholdParam { nullptr };
+    
+    juce::AudioParameterChoice* lowRatioParam { nullptr };
+    juce::AudioParameterChoice* midRatioParam { nullptr };
+    juce::AudioParameterChoice* highRatioParam { nullptr };
+    
+    //Only the parameters above are listened to. processFrame() takes whatever changed once per frame.
+    ParameterSubscription parameterSubscription;
+    ParameterSubscription::Mask crossoverParameterBits = 0;
+    
+    float lowBandGR { 0.f }, midBandGR { 0.f }, highBandGR { 0.f };
+    
+    std::vector<float> getFrequencies();
+    std::vector<float> getGains();
+    std::vector<float> getXs(const std::vector<float>& freqs, float left, float width);
+
+    juce::Rectangle<int> getRenderArea(juce::Rectangle<int> bounds);
+    
+    juce::Rectangle<int> getAnalysisArea(juce::Rectangle<int> bounds);
+    
+    //The analysis area in component coordinates, set in resized()
+    juce::Rectangle<int> analysisArea;
+    
+    //Where the overlays were last drawn, in whole pixels.
+    //processFrame() compares against this to find the regions that need repainting.
+    struct OverlayGeometry
+    {
+        int lowMidX = 0, midHighX = 0;
+        std::array<int, 3> thresholdYs { }, gainReductionYs { };
+    };
+    
+    OverlayGeometry drawnOverlay;
+    
+    int mapFrequencyToX(float frequency) const;
+    int mapDecibelsToY(float db) const;
+    
+    void updateParameterOverlay(OverlayGeometry& geometry) const;
+    void updateGainReductionOverlay(OverlayGeometry& geometry) const;
+    void repaintChangedOverlays(const OverlayGeometry& newOverlay);
+    
+    //The module background, grid and text labels only change when the component
+    //is resized or moved to a display with a different scale, so they are rendered
+    //once into this image and blitted every frame.
+    struct StaticLayer
+    {
+        juce::Image image;
+        
+        //what it was rendered for
+        juce::Rectangle<int> bounds;
+        float scale { 0.f };
+        DisplayMode mode { DisplayMode::spectrum };
+        
+        bool matches(juce::Rectangle<int> b, float s, DisplayMode m) const
+        {
+            return image.isValid() && bounds == b && scale == s && mode == m;
+        }
+    };
+    
+    StaticLayer staticLayer;
+    
+    //Only reads what it is given, so it can run on the backgroundPool
+    StaticLayer renderStaticLayer(juce::Rectangle<int> bounds, float scale, DisplayMode mode);
+    
+    /*
+     While the editor is being resized, the last static layer, the spectrogram and the
+     response overlay are stretched to fit instead of being rebuilt at every step.
+     When the resize is over, the static layer is rendered on the backgroundPool and
+     picked up by processFrame(), and the old one is stretched until it arrives.
+     */
+    bool liveResize = false;
+    bool staticLayerPending = false;
+    
+    juce::SpinLock renderedStaticLayerLock;
+    std::optional<StaticLayer> renderedStaticLayer;
+    
+    void resizeHistories();
+    void pullRenderedStaticLayer();
+    
+    //Both taps draw into the same area, so they share one bin -> pixel table.
+    //Only the analysis thread touches it.
+    BinToPixelMap binToPixelMap;
+    
+    //The input (before the input gain) and output (after the output gain) spectra
+    PathProducer prePathProducer, postPathProducer;
+    
+    StereoImageAnalysis stereoImageAnalysis;
+    
+    //The area the analysis thread generates paths for, set in resized()
+    juce::SpinLock analysisBoundsLock;
+    juce::Rectangle<float> analysisBounds;
+    
+    //The one thread that runs the analysis for both taps.
+    //The timer wakes it up once per frame.
+    struct AnalysisThread : juce::Thread
+    {
+        AnalysisThread(SpectrumAnalyzer& owner) : juce::Thread("Spectrum Analyzer"), analyzer(owner) { }
+        void run() override;
+        SpectrumAnalyzer& analyzer;
+    };
+    
+    AnalysisThread analysisThread { *this };
+    bool analysisRunsOnThread = true;
+    
+    std::optional<FFTOrder> userFFTOrder;
+    
+    //empty until the first frame, which is when the engines are first built
+    std::optional<FFTOrder> requestedFFTOrder;
+    
+    void updateFFTOrder();
+    
+    //The crossover responses and compression curves, rebuilt on the backgroundPool
+    //whenever one of the parameters they show changes
+    ResponseOverlay responseOverlay;
+    
+    void updateResponseOverlay();
+    
+    //Builds new FFT engines and overlay paths off the message thread.
+    //This must be declared after the PathProducers and the overlay so it is destroyed first,
+    //which waits for any job still writing into them.
+    juce::ThreadPool backgroundPool { 1 };
+};
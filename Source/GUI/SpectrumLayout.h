@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    SpectrumLayout.h
+    Created: 19 Oct 2026 5:22:07pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Describes where the bins of a spectrum sit in frequency.
+ 
+ A plain FFT gives linearly spaced bins (bin * binWidth),
+ the multi-resolution analyzer gives logarithmically spaced ones.
+ Everything downstream of the FFT (smoothing, the bin -> pixel tables, the spectrogram)
+ goes through this, so it works with either.
+ */
+struct SpectrumLayout
+{
+    //bin 0 is DC, each bin is 'binWidth' Hz above the previous one
+    static SpectrumLayout linear(int numBins, float binWidth)
+    {
+        SpectrumLayout layout;
+        layout.numBins = numBins;
+        layout.step = binWidth;
+        return layout;
+    }
+    
+    //bin 0 is 'lowestFrequency', each bin is 1/binsPerOctave of an octave above the previous one
+    static SpectrumLayout logarithmic(float lowestFrequency, float highestFrequency, int binsPerOctave)
+    {
+        SpectrumLayout layout;
+        layout.isLogarithmic = true;
+        layout.firstFrequency = lowestFrequency;
+        layout.step = 1.f / static_cast<float>(binsPerOctave);
+        layout.numBins = 1 + static_cast<int>(std::ceil(std::log2(highestFrequency / lowestFrequency) * binsPerOctave));
+        return layout;
+    }
+    
+    //the centre frequency of a (fractional) bin
+    float getFrequency(float bin) const
+    {
+        return isLogarithmic ? firstFrequency * std::exp2(bin * step) : bin * step;
+    }
+    
+    //the (fractional) bin a frequency falls on, which can be outside [0, numBins)
+    float getBin(float frequency) const
+    {
+        if( ! isLogarithmic )
+            return frequency / step;
+        
+        return frequency > 0.f ? std::log2(frequency / firstFrequency) / step : -std::numeric_limits<float>::infinity();
+    }
+    
+    //the lowest bin that holds a usable level. DC isn't, in a linear layout.
+    int getFirstUsableBin() const { return isLogarithmic ? 0 : 1; }
+    
+    bool isValid() const { return numBins >= 2 && step > 0.f; }
+    
+    bool operator==(const SpectrumLayout& other) const
+    {
+        return numBins == other.numBins
+            && isLogarithmic == other.isLogarithmic
+            && firstFrequency == other.firstFrequency
+            && step == other.step;
+    }
+    
+    bool operator!=(const SpectrumLayout& other) const { return ! (*this == other); }
+    
+    int numBins = 0;
+    bool isLogarithmic = false;
+    float firstFrequency = 0.f;
+    
+    //Hz per bin when linear, octaves per bin when logarithmic
+    float step = 0.f;
+};
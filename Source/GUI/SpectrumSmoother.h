@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    SpectrumSmoother.h
+    Created: 19 Oct 2026 2:41:18pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utilities.h"
+#include "AnalyzerKernels.h"
+#include "SpectrumLayout.h"
+
+/*
+ Sits between the FFTDataGenerator and the AnalyzerPathGenerator.
+ Every FFT frame is fed in, and the display is drawn from the result, so no
+ computed frame is wasted and the trace stops flickering.
+ 
+ Each frame is:
+    - smoothed across frequency with 1/N octave kernels,
+    - averaged over time with a one-pole filter,
+    - and tracked by a peak hold that decays after a hold time.
+ 
+ All values are in dB.
+ */
+struct SpectrumSmoother
+{
+    /**
+     Rebuilds the smoothing kernels and resets the state if the bin layout changed.
+     Call this before every batch of frames, it does nothing if nothing changed.
+     */
+    void prepare(const SpectrumLayout& layout)
+    {
+        if( layout == preparedLayout )
+            return;
+        
+        preparedLayout = layout;
+        
+        preparedNumBins = layout.numBins;
+        const auto numBins = preparedNumBins;
+        
+        smoothed.assign(numBins, NEGATIVE_INFINITY);
+        averaged.assign(numBins, NEGATIVE_INFINITY);
+        peaks.assign(numBins, NEGATIVE_INFINITY);
+        holdRemaining.assign(numBins, 0.f);
+        runningSum.assign(numBins + 1, 0.0);
+        
+        buildKernels();
+    }
+    
+    /**
+     Feeds one FFT frame in. 'frameSeconds' is how much new audio the frame covers.
+     */
+    void process(const std::vector<float>& frame, float frameSeconds)
+    {
+        jassert( static_cast<int>(frame.size()) >= preparedNumBins );
+        
+        const auto* input = frame.data();
+        
+        if( octaveFraction > 0 )
+        {
+            AnalyzerKernels::applySmoothingKernels(input,
+                                                   kernels.data(),
+                                                   preparedNumBins,
+                                                   runningSum.data(),
+                                                   smoothed.data());
+            input = smoothed.data();
+        }
+        
+        auto averagingCoefficient = averagingSeconds > 0.f ?
+                                    1.f - std::exp(-frameSeconds / averagingSeconds) :
+                                    1.f;
+        
+        AnalyzerKernels::exponentialAverage(input, averaged.data(), preparedNumBins, averagingCoefficient);
+        
+        AnalyzerKernels::peakHold(input,
+                                  peaks.data(),
+                                  holdRemaining.data(),
+                                  preparedNumBins,
+                                  peakHoldSeconds,
+                                  frameSeconds,
+                                  peakDecayDbPerSecond * frameSeconds);
+    }
+    
+    const std::vector<float>& getAveraged() const { return averaged; }
+    const std::vector<float>& getPeaks() const { return peaks; }
+    
+    //==============================================================================
+    
+    //0 turns frequency smoothing off, otherwise each bin is smoothed over 1/N of an octave
+    void setOctaveFraction(int newOctaveFraction)
+    {
+        octaveFraction = newOctaveFraction;
+        buildKernels();
+    }
+    
+    void setAveragingTime(float seconds) { averagingSeconds = seconds; }
+    
+    void setPeakHold(float holdSeconds, float decayDbPerSecond)
+    {
+        peakHoldSeconds = holdSeconds;
+        peakDecayDbPerSecond = decayDbPerSecond;
+    }
+private:
+    int octaveFraction = 12;
+    float averagingSeconds = 0.15f;
+    float peakHoldSeconds = 1.f;
+    float peakDecayDbPerSecond = 12.f;
+    
+    int preparedNumBins = 0;
+    SpectrumLayout preparedLayout;
+    
+    std::vector<AnalyzerKernels::SmoothingKernel> kernels;
+    std::vector<float> smoothed, averaged, peaks, holdRemaining;
+    std::vector<double> runningSum;
+    
+    void buildKernels()
+    {
+        kernels.resize(preparedNumBins);
+        
+        if( octaveFraction <= 0 )
+            return;
+        
+        //each bin covers +/- half of the 1/N octave band around it
+        const auto halfBand = std::pow(2.0, 0.5 / static_cast<double>(octaveFraction));
+        
+        for( int bin = 0; bin < preparedNumBins; ++bin )
+        {
+            auto frequency = preparedLayout.getFrequency(static_cast<float>(bin));
+            
+            auto firstBin = static_cast<int>(std::floor(preparedLayout.getBin(static_cast<float>(frequency / halfBand)) + 0.5f));
+            auto lastBin = static_cast<int>(std::floor(preparedLayout.getBin(static_cast<float>(frequency * halfBand)) + 0.5f));
+            
+            firstBin = juce::jlimit(0, bin, firstBin);
+            lastBin = juce::jlimit(bin, preparedNumBins - 1, lastBin);
+            
+            kernels[bin].firstBin = firstBin;
+            kernels[bin].numBins = lastBin - firstBin + 1;
+        }
+    }
+};
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    StereoImageAnalysis.h
+    Created: 19 Oct 2026 10:31:47pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "AnalyzerKernels.h"
+
+/*
+ The analysis half of the correlation meter and goniometer.
+ 
+ It is fed the output's stereo blocks on the analyzer's analysis thread, as PathProducer pulls
+ them from the post-processing SCSFs, so it reuses the audio the spectrum already receives
+ instead of needing FIFOs of its own.
+ 
+ The correlation is a running sum of products: each block's sums are added to totals
+ that decay exponentially, so the meter integrates over roughly correlationSeconds.
+ The goniometer points are the samples turned 45 degrees (mid up, side across), and are
+ handed to the message thread through a Fifo, one block at a time.
+ */
+struct StereoImageAnalysis
+{
+    //larger blocks are thinned out evenly to this many points
+    static constexpr int maxPointsPerBlock = 1024;
+    
+    static constexpr double correlationSeconds = 0.3;
+    
+    StereoImageAnalysis()
+    {
+        pointFifo.prepare(static_cast<size_t>(2 * maxPointsPerBlock));
+    }
+    
+    //analysis thread
+    void process(const float* left, const float* right, int numSamples, double sampleRate)
+    {
+        if( numSamples <= 0 || sampleRate <= 0.0 )
+            return;
+        
+        auto sums = AnalyzerKernels::sumStereoProducts(left, right, numSamples);
+        
+        //the totals fall to 1/e of themselves every correlationSeconds
+        auto decay = std::exp(-numSamples / (correlationSeconds * sampleRate));
+        
+        totals.leftRight = totals.leftRight * decay + sums.leftRight;
+        totals.leftLeft = totals.leftLeft * decay + sums.leftLeft;
+        totals.rightRight = totals.rightRight * decay + sums.rightRight;
+        
+        //silence has no phase, so it reads as neither in nor out of phase
+        auto power = std::sqrt(totals.leftLeft * totals.rightRight);
+        correlation.store(power > 1.0e-9 ? static_cast<float>(totals.leftRight / power) : 0.f);
+        
+        const auto stride = (numSamples + maxPointsPerBlock - 1) / maxPointsPerBlock;
+        
+        pointFifo.pushInPlace([=](std::vector<float>& points)
+        {
+            //the slots keep their capacity, so this only allocates if one came back small from pullPoints()
+            points.clear();
+            
+            for( int i = 0; i < numSamples; i += stride )
+            {
+                constexpr float rotation = juce::MathConstants<float>::sqrt2 / 2.f;
+                
+                //side across (left to the left), mid up
+                points.push_back((right[i] - left[i]) * rotation);
+                points.push_back((left[i] + right[i]) * rotation);
+            }
+        });
+    }
+    
+    //any thread. +1 is mono, 0 is unrelated (or silent), -1 is one channel inverted.
+    float getCorrelation() const { return correlation.load(); }
+    
+    //message thread. 'points' gets the oldest block's x, y pairs, see Fifo::pullAndRecycle()
+    bool pullPoints(std::vector<float>& points) { return pointFifo.pullAndRecycle(points); }
+    int getNumPointBlocksAvailable() const { return pointFifo.getNumAvailableForReading(); }
+private:
+    AnalyzerKernels::StereoProducts totals;
+    std::atomic<float> correlation { 0.f };
+    
+    Fifo<std::vector<float>> pointFifo;
+};
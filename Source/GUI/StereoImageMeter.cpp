@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    StereoImageMeter.cpp
+    Created: 19 Oct 2026 10:44:09pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#include "StereoImageMeter.h"
+#include "../Utilities.h"
+
+StereoImageMeter::StereoImageMeter(StereoImageAnalysis& a) :
+analysis(a)
+{
+    setOpaque(true);
+}
+
+void StereoImageMeter::paint(juce::Graphics& g)
+{
+    using namespace juce;
+    
+    drawModuleBackground(g, getLocalBounds());
+    
+    //the axes: left and right on the diagonals, mono straight up
+    {
+        auto area = scopeArea.toFloat();
+        
+        g.setColour(Colours::dimgrey);
+        g.drawLine(area.getX(), area.getY(), area.getRight(), area.getBottom(), 1.f);
+        g.drawLine(area.getRight(), area.getY(), area.getX(), area.getBottom(), 1.f);
+        g.drawVerticalLine(scopeArea.getCentreX(), area.getY(), area.getBottom());
+        
+        g.setFont(10);
+        g.setColour(Colours::lightgrey);
+        g.drawText("L", scopeArea.withSize(12, 12).translated(2, 0), Justification::centred);
+        g.drawText("R", scopeArea.withSize(12, 12).translated(scopeArea.getWidth() - 14, 0), Justification::centred);
+    }
+    
+    //the trace, tinted with the output spectrum's colour
+    if( scope.isValid() )
+    {
+        g.setColour(Colour(215u, 201u, 134u));
+        g.drawImageAt(scope, scopeArea.getX(), scopeArea.getY(), true);
+    }
+    
+    //the correlation, a bar from the centre out to the current value.
+    //Out of phase (below zero) is what the meter is here to catch, so it's red.
+    {
+        auto bar = correlationArea.reduced(0, 4);
+        auto zeroX = mapCorrelationToX(0.f);
+        auto valueX = mapCorrelationToX(shownCorrelation / 100.f);
+        
+        g.setColour(Colours::darkgrey);
+        g.fillRect(bar);
+        
+        g.setColour(shownCorrelation < 0 ? Colours::red : Colours::limegreen);
+        g.fillRect(Rectangle<int>::leftTopRightBottom(jmin(zeroX, valueX), bar.getY(), jmax(zeroX, valueX) + 1, bar.getBottom()));
+        
+        g.setColour(Colours::lightgrey);
+        g.drawVerticalLine(zeroX, float(bar.getY()), float(bar.getBottom()));
+        
+        g.setFont(10);
+        g.drawText("-1", correlationArea.withWidth(14), Justification::centredLeft);
+        g.drawText("+1", correlationArea.withTrimmedLeft(correlationArea.getWidth() - 14), Justification::centredRight);
+    }
+}
+
+void StereoImageMeter::resized()
+{
+    //same inset as drawModuleBackground()
+    auto bounds = getLocalBounds().reduced(3);
+    
+    correlationArea = bounds.removeFromBottom(16).reduced(4, 0);
+    
+    auto size = juce::jmin(bounds.getWidth(), bounds.getHeight()) - 4;
+    scopeArea = bounds.withSizeKeepingCentre(size, size);
+    
+    scope = size > 0 ? juce::Image(juce::Image::SingleChannel, size, size, true) : juce::Image();
+    scopeIsLit = false;
+}
+
+void StereoImageMeter::processFrame()
+{
+    bool needsRepaint = false;
+    
+    //Refresh rates differ between displays and frames get skipped,
+    //so the fade goes by how long it has been since the last frame
+    auto now = juce::Time::getMillisecondCounterHiRes();
+    auto elapsedSeconds = juce::jlimit(0.0, 1.0, (now - lastFrameTime) * 0.001);
+    lastFrameTime = now;
+    
+    if( scopeIsLit )
+    {
+        scopeIsLit = fadeScope(elapsedSeconds);
+        needsRepaint = true;
+    }
+    
+    while( analysis.getNumPointBlocksAvailable() > 0 )
+    {
+        if( analysis.pullPoints(points) && ! points.empty() )
+        {
+            plotPoints(points);
+            scopeIsLit = needsRepaint = true;
+        }
+    }
+    
+    if( needsRepaint )
+        repaint(scopeArea);
+    
+    auto correlation = juce::roundToInt(analysis.getCorrelation() * 100.f);
+    
+    if( correlation != shownCorrelation )
+    {
+        shownCorrelation = correlation;
+        repaint(correlationArea);
+    }
+}
+
+bool StereoImageMeter::fadeScope(double elapsedSeconds)
+{
+    if( scope.isNull() )
+        return false;
+    
+    //how much of its brightness a pixel keeps, out of 256
+    const auto persistence = juce::jlimit(0, 256, juce::roundToInt(256.0 * std::exp(-elapsedSeconds / fadeSeconds)));
+    
+    juce::Image::BitmapData pixels(scope, juce::Image::BitmapData::readWrite);
+    
+    int anyLit = 0;
+    
+    for( int y = 0; y < pixels.height; ++y )
+    {
+        auto* line = pixels.getLinePointer(y);
+        
+        //a plain loop over bytes, which vectorizes
+        for( int x = 0; x < pixels.width; ++x )
+        {
+            auto faded = (line[x] * persistence) >> 8;
+            line[x] = static_cast<juce::uint8>(faded);
+            anyLit |= faded;
+        }
+    }
+    
+    return anyLit != 0;
+}
+
+void StereoImageMeter::plotPoints(const std::vector<float>& newPoints)
+{
+    if( scope.isNull() )
+        return;
+    
+    juce::Image::BitmapData pixels(scope, juce::Image::BitmapData::readWrite);
+    
+    //a full scale mono signal reaches the top. A full scale signal in one channel only gets
+    //halfway out along its diagonal, to (-0.707, 0.707) for the left and (0.707, 0.707) for the right.
+    const auto range = juce::MathConstants<float>::sqrt2;
+    const auto maxX = static_cast<float>(pixels.width - 1);
+    const auto maxY = static_cast<float>(pixels.height - 1);
+    
+    for( size_t i = 0; i + 1 < newPoints.size(); i += 2 )
+    {
+        auto x = juce::roundToInt(juce::jmap(newPoints[i], -range, range, 0.f, maxX));
+        auto y = juce::roundToInt(juce::jmap(newPoints[i + 1], -range, range, maxY, 0.f));
+        
+        if( x < 0 || y < 0 || x >= pixels.width || y >= pixels.height )
+            continue;
+        
+        auto* pixel = pixels.getPixelPointer(x, y);
+        *pixel = static_cast<juce::uint8>(juce::jmin(255, *pixel + pointBrightness));
+    }
+}
+
+int StereoImageMeter::mapCorrelationToX(float correlation) const
+{
+    auto bar = correlationArea.reduced(16, 0);
+    return juce::roundToInt(juce::jmap(correlation, -1.f, 1.f, float(bar.getX()), float(bar.getRight())));
+}
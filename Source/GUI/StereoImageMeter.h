@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    StereoImageMeter.h
+    Created: 19 Oct 2026 10:44:09pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "StereoImageAnalysis.h"
+
+/*
+ A goniometer above a correlation meter, for the plugin's output.
+ 
+ The goniometer is a point cloud with persistence: every frame the image fades by however
+ much time has passed and the newest points are added on top, so the trace lingers and busy areas glow.
+ The image only holds brightness, one byte per pixel, and is tinted when it's drawn,
+ so fading it is one multiply per pixel, and nothing is allocated after resized().
+ */
+struct StereoImageMeter : juce::Component
+{
+    StereoImageMeter(StereoImageAnalysis&);
+    
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    
+    /**
+     Called by the editor once per display refresh.
+     Plots whatever arrived and fades everything else.
+     Stops repainting once the trace has faded out and the correlation is steady.
+     */
+    void processFrame();
+private:
+    StereoImageAnalysis& analysis;
+    
+    juce::Image scope;
+    juce::Rectangle<int> scopeArea, correlationArea;
+    
+    //the last block of points pulled, kept so its storage can be recycled
+    std::vector<float> points;
+    
+    //how long a pixel takes to fade to about a third of its brightness
+    static constexpr double fadeSeconds = 0.1;
+    double lastFrameTime = 0.0;
+    
+    //how much brighter a pixel gets for every point that lands on it
+    static constexpr int pointBrightness = 40;
+    
+    //once everything has faded out, fading again changes nothing
+    bool scopeIsLit = false;
+    
+    //the correlation as drawn, in hundredths
+    int shownCorrelation = 0;
+    
+    //returns whether any pixel is still lit
+    bool fadeScope(double elapsedSeconds);
+    void plotPoints(const std::vector<float>& newPoints);
+    
+    int mapCorrelationToX(float correlation) const;
+};
@@ -1,158 +1,324 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-//==============================================================================
-
-
-
-SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
-{
-    
-    //==============================================================================
-    //==============================================================================
-    
-    addAndMakeVisible(controlBar);
-    addAndMakeVisible(analyzer);
-    addAndMakeVisible(globalControls);
-    addAndMakeVisible(bandControls);
-    
-    setLookAndFeel(&lnf);
-    
-    controlBar.analyzerButton.onClick = [this]()
-    {
-        analyzer.toggleAnalysisEnablement(controlBar.analyzerButton.getToggleState());
-    };
-    
-    controlBar.globalBypassButton.onClick = [this]()
-    {
-        toggleGlobalBypassState();
-    };
-    
-    //==============================================================================
-    //==============================================================================
-    
-    // Make sure that before the constructor has finished, you've set the
-    // editor's size to whatever you need it to be.
-    setSize (900, 750);
-    
-    startTimerHz(60);
-}
-
-SimpleMBCompAudioProcessorEditor::~SimpleMBCompAudioProcessorEditor()
-{
-    setLookAndFeel(nullptr);
-}
-
-//==============================================================================
-void SimpleMBCompAudioProcessorEditor::paint (juce::Graphics& g)
-{
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (juce::Colours::black);
-
-//    g.setColour (juce::Colours::white);
-//    g.setFont (15.0f);
-//    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
-}
-
-void SimpleMBCompAudioProcessorEditor::resized()
-{
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
-    
-    
-    auto bounds = getLocalBounds();
-    
-    controlBar.setBounds(bounds.removeFromTop(//35
-                                              42));
-    bandControls.setBounds(bounds.removeFromBottom(//125
-                                                   201));
-    analyzer.setBounds(bounds.removeFromTop(//215
-                                            300));
-    globalControls.setBounds(bounds);
-    
-}
-
-void SimpleMBCompAudioProcessorEditor::timerCallback()
-{
-    std::vector<float> values
-    {
-        audioProcessor.lowBandComp.getRMSInputLevelDb(),
-        audioProcessor.lowBandComp.getRMSOutputLevelDb(),
-        audioProcessor.midBandComp.getRMSInputLevelDb(),
-        audioProcessor.midBandComp.getRMSOutputLevelDb(),
-        audioProcessor.highBandComp.getRMSInputLevelDb(),
-        audioProcessor.highBandComp.getRMSOutputLevelDb()
-    };
-    
-    analyzer.update(values);
-    
-    updateGlobalBypassButton();
-}
-
-void SimpleMBCompAudioProcessorEditor::toggleGlobalBypassState()
-{
-    auto shouldEnableEverything = !controlBar.globalBypassButton.getToggleState();
-    
-    auto params = getBypassParams();
-    
-    auto bypassParamHelper = [](auto* param, bool shouldBeBypassed)
-    {
-        param->beginChangeGesture();
-        param->setValueNotifyingHost( shouldBeBypassed ? 1.f : 0.f );
-        param->endChangeGesture();
-    };
-    
-    for( auto* param : params )
-    {
-        bypassParamHelper(param, !shouldEnableEverything);
-    };
-    
-    bandControls.toggleAllBands(!shouldEnableEverything);
-}
-
-std::array<juce::AudioParameterBool*, 3> SimpleMBCompAudioProcessorEditor::getBypassParams()
-{
-    using namespace juce;
-    using namespace Params;
-    
-    auto& apvts = audioProcessor.apvts;
-    const auto& params = Params::GetParams();
-    
-    auto boolHelper = [&apvts, &params](const auto& paramName)
-    {
-        auto param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
-        jassert(param != nullptr);
-        return param;
-    };
-    
-    auto* lowBypassParam = boolHelper(Names::Bypassed_Low_Band);
-    auto* midBypassParam = boolHelper(Names::Bypassed_Mid_Band);
-    auto* highBypassParam = boolHelper(Names::Bypassed_High_Band);
-    
-    return
-    {
-        lowBypassParam,
-        midBypassParam,
-        highBypassParam
-    };
-}
-
-void SimpleMBCompAudioProcessorEditor::updateGlobalBypassButton()
-{
-    auto params = getBypassParams();
-    
-    bool allBandAreBypassed = std::all_of(params.begin(),
-                                          params.end(),
-                                          [](const auto& param) { return param->get(); });
-    
-    controlBar.globalBypassButton.setToggleState( allBandAreBypassed, juce::NotificationType::dontSendNotification);
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+
+
+
+SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor& p)
+    : AudioProcessorEditor (&p), audioProcessor (p)
+{
+    
+    //==============================================================================
+    //==============================================================================
+    
+    addAndMakeVisible(controlBar);
+    addAndMakeVisible(analyzer);
+    addAndMakeVisible(gainReductionHistory);
+    addAndMakeVisible(stereoImageMeter);
+    addAndMakeVisible(levelMeters);
+    addAndMakeVisible(globalControls);
+    addAndMakeVisible(bandControls);
+    
+    setLookAndFeel(&lnf.get());
+    
+    controlBar.analyzerButton.onClick = [this]()
+    {
+        analyzer.toggleAnalysisEnablement(controlBar.analyzerButton.getToggleState());
+    };
+    
+    controlBar.fftOrderSelector.onChange = [this]()
+    {
+        auto selectedId = controlBar.fftOrderSelector.getSelectedId();
+        
+        analyzer.setMultiResolution(selectedId == ControlBar::FFTOrderSelectorIds::MultiResolutionFFT);
+        
+        if( selectedId == ControlBar::FFTOrderSelectorIds::MultiResolutionFFT )
+            return;
+        
+        if( selectedId == ControlBar::FFTOrderSelectorIds::AutoFFTOrder )
+            analyzer.setFFTOrderFollowsSampleRate();
+        else
+            analyzer.setFFTOrder(static_cast<FFTOrder>(selectedId));
+    };
+    
+    controlBar.displayModeSelector.onChange = [this]()
+    {
+        using DisplayMode = SpectrumAnalyzer::DisplayMode;
+        
+        switch( controlBar.displayModeSelector.getSelectedId() )
+        {
+            case ControlBar::DisplayModeSelectorIds::SpectrogramDisplay:
+                analyzer.setDisplayMode(DisplayMode::spectrogram);
+                break;
+            case ControlBar::DisplayModeSelectorIds::BandDisplay:
+                analyzer.setDisplayMode(DisplayMode::bands);
+                break;
+            default:
+                analyzer.setDisplayMode(DisplayMode::spectrum);
+                break;
+        }
+    };
+    
+    controlBar.loudnessDisplay.onReset = [this]()
+    {
+        audioProcessor.loudnessMeter.reset();
+        audioProcessor.resetClipCounters();
+    };
+    
+    levelMeters.onReset = [this]()
+    {
+        audioProcessor.resetClipCounters();
+    };
+    
+    controlBar.globalBypassButton.onClick = [this]()
+    {
+        toggleGlobalBypassState();
+    };
+    
+    //==============================================================================
+    //==============================================================================
+    
+    setResizable(true, true);
+    setResizeLimits(designWidth * 4 / 5, designHeight * 4 / 5, designWidth * 2, designHeight * 2);
+    getConstrainer()->setFixedAspectRatio(static_cast<double>(designWidth) / designHeight);
+    
+    // Make sure that before the constructor has finished, you've set the
+    // editor's size to whatever you need it to be.
+    setSize (designWidth, designHeight);
+    
+    openLatency.constructionMs = 1000.0 * juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - openStartTicks);
+}
+
+SimpleMBCompAudioProcessorEditor::~SimpleMBCompAudioProcessorEditor()
+{
+    //the look-and-feel is shared, so it must not be left thinking this editor is still resizing
+    if( liveResize )
+        lnf->endLiveResize();
+    
+    setLookAndFeel(nullptr);
+}
+
+//==============================================================================
+void SimpleMBCompAudioProcessorEditor::paint (juce::Graphics& g)
+{
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    g.fillAll (juce::Colours::black);
+
+//    g.setColour (juce::Colours::white);
+//    g.setFont (15.0f);
+//    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
+}
+
+void SimpleMBCompAudioProcessorEditor::paintOverChildren (juce::Graphics&)
+{
+    //this runs after every child has painted, so the first one marks the end of opening the editor
+    if( openLatency.firstPaintMs > 0.0 )
+        return;
+    
+    openLatency.firstPaintMs = 1000.0 * juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - openStartTicks);
+}
+
+void SimpleMBCompAudioProcessorEditor::resized()
+{
+    // This is generally where you'll want to lay out the positions of any
+    // subcomponents in your editor..
+    
+    //Nothing is on screen before the editor is shown, so only resizes after that are live.
+    //This has to start before the components get their new bounds, so they know to stretch.
+    if( isShowing() )
+    {
+        lastResizeTicks = juce::Time::getHighResolutionTicks();
+        
+        if( ! liveResize )
+            beginLiveResize();
+    }
+    
+    auto key = std::make_pair(getWidth(), getHeight());
+    auto cached = layoutCache.find(key);
+    
+    if( cached == layoutCache.end() )
+    {
+        if( layoutCache.size() >= maxCachedLayouts )
+            layoutCache.clear();
+        
+        cached = layoutCache.emplace(key, computeLayout(getLocalBounds())).first;
+    }
+    
+    const auto& layout = cached->second;
+    
+    controlBar.setBounds(layout.controlBar);
+    bandControls.setBounds(layout.bandControls);
+    analyzer.setBounds(layout.analyzer);
+    gainReductionHistory.setBounds(layout.gainReductionHistory);
+    stereoImageMeter.setBounds(layout.stereoImageMeter);
+    levelMeters.setBounds(layout.levelMeters);
+    globalControls.setBounds(layout.globalControls);
+}
+
+SimpleMBCompAudioProcessorEditor::Layout SimpleMBCompAudioProcessorEditor::computeLayout(juce::Rectangle<int> bounds)
+{
+    //the aspect ratio is fixed, so the height alone gives the scale
+    auto scale = bounds.getHeight() / static_cast<float>(designHeight);
+    auto scaled = [scale](int designSize) { return juce::roundToInt(designSize * scale); };
+    
+    Layout layout;
+    
+    layout.controlBar = bounds.removeFromTop(scaled(42));
+    layout.bandControls = bounds.removeFromBottom(scaled(201));
+    layout.analyzer = bounds.removeFromTop(scaled(300));
+    layout.gainReductionHistory = bounds.removeFromTop(scaled(60));
+    
+    //the goniometer is square, at the right of the global controls
+    layout.stereoImageMeter = bounds.removeFromRight(bounds.getHeight());
+    
+    //with the level meters to its left
+    layout.levelMeters = bounds.removeFromRight(scaled(100));
+    layout.globalControls = bounds;
+    
+    return layout;
+}
+
+void SimpleMBCompAudioProcessorEditor::beginLiveResize()
+{
+    liveResize = true;
+    
+    lnf->beginLiveResize();
+    analyzer.setLiveResize(true);
+    gainReductionHistory.setLiveResize(true);
+}
+
+void SimpleMBCompAudioProcessorEditor::endLiveResize()
+{
+    liveResize = false;
+    
+    lnf->endLiveResize();
+    analyzer.setLiveResize(false);
+    gainReductionHistory.setLiveResize(false);
+    
+    //the knobs were stretched from other sizes, this renders them at their own
+    repaint();
+}
+
+void SimpleMBCompAudioProcessorEditor::vBlankCallback()
+{
+    if( liveResize )
+    {
+        auto secondsSinceResize = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - lastResizeTicks);
+        
+        if( secondsSinceResize > liveResizeTimeoutSeconds )
+            endLiveResize();
+    }
+    
+    //only a new block can change the meters
+    auto version = audioProcessor.meterTelemetry.getVersion();
+    
+    if( version != meterSnapshotVersion && audioProcessor.meterTelemetry.read(meterSnapshot) )
+    {
+        meterSnapshotVersion = version;
+        analyzer.update(meterSnapshot);
+        levelMeters.update(meterSnapshot);
+    }
+    
+    analyzer.processFrame();
+    gainReductionHistory.processFrame();
+    stereoImageMeter.processFrame();
+    
+    auto& loudness = audioProcessor.loudnessMeter;
+    controlBar.loudnessDisplay.setValues(loudness.getMomentaryLoudness(),
+                                         loudness.getShortTermLoudness(),
+                                         loudness.getIntegratedLoudness(),
+                                         loudness.getTruePeak());
+    
+    updateGlobalBypassButton();
+}
+
+std::vector<std::pair<juce::String, juce::Component*>> SimpleMBCompAudioProcessorEditor::getComponentsToProfile()
+{
+    RotarySliderWithLabels* slider = nullptr;
+    for( auto* child : globalControls.getChildren() )
+    {
+        if( (slider = dynamic_cast<RotarySliderWithLabels*>(child)) != nullptr )
+            break;
+    }
+    
+    return
+    {
+        { "Editor (everything)", this },
+        { "SpectrumAnalyzer", &analyzer },
+        { "GainReductionHistory", &gainReductionHistory },
+        { "StereoImageMeter", &stereoImageMeter },
+        { "LevelMeters", &levelMeters },
+        { "CompressorBandControls", &bandControls },
+        { "GlobalControls", &globalControls },
+        { "ControlBar", &controlBar },
+        { "RotarySliderWithLabels", slider }
+    };
+}
+
+void SimpleMBCompAudioProcessorEditor::toggleGlobalBypassState()
+{
+    auto shouldEnableEverything = !controlBar.globalBypassButton.getToggleState();
+    
+    auto params = getBypassParams();
+    
+    auto bypassParamHelper = [](auto* param, bool shouldBeBypassed)
+    {
+        param->beginChangeGesture();
+        param->setValueNotifyingHost( shouldBeBypassed ? 1.f : 0.f );
+        param->endChangeGesture();
+    };
+    
+    for( auto* param : params )
+    {
+        bypassParamHelper(param, !shouldEnableEverything);
+    };
+    
+    bandControls.toggleAllBands(!shouldEnableEverything);
+}
+
+std::array<juce::AudioParameterBool*, 3> SimpleMBCompAudioProcessorEditor::getBypassParams()
+{
+    using namespace juce;
+    using namespace Params;
+    
+    auto& apvts = audioProcessor.apvts;
+    const auto& params = Params::GetParams();
+    
+    auto boolHelper = [&apvts, &params](const auto& paramName)
+    {
+        auto param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
+        jassert(param != nullptr);
+        return param;
+    };
+    
+    auto* lowBypassParam = boolHelper(Names::Bypassed_Low_Band);
+    auto* midBypassParam = boolHelper(Names::Bypassed_Mid_Band);
+    auto* highBypassParam = boolHelper(Names::Bypassed_High_Band);
+    
+    return
+    {
+        lowBypassParam,
+        midBypassParam,
+        highBypassParam
+    };
+}
+
+void SimpleMBCompAudioProcessorEditor::updateGlobalBypassButton()
+{
+    auto params = getBypassParams();
+    
+    bool allBandAreBypassed = std::all_of(params.begin(),
+                                          params.end(),
+                                          [](const auto& param) { return param->get(); });
+    
+    controlBar.globalBypassButton.setToggleState( allBandAreBypassed, juce::NotificationType::dontSendNotification);
+}
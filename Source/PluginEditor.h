@@ -1,58 +1,125 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-#include "GUI/LookAndFeel.h"
-#include "GUI/Placeholder.h"
-#include "GUI/GlobalControls.h"
-#include "GUI/CompressorBandControls.h"
-#include "GUI/SpectrumAnalyzer.h"
-#include "GUI/ControlBar.h"
-
-
-class SimpleMBCompAudioProcessorEditor  : public juce::AudioProcessorEditor, juce::Timer
-{
-public:
-    SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor&);
-    ~SimpleMBCompAudioProcessorEditor() override;
-
-    //==============================================================================
-    void paint (juce::Graphics&) override;
-    void resized() override;
-    void timerCallback() override;
-
-private:
-    // This reference is provided as a quick way for your editor to
-    // access the processor object that created it.
-    SimpleMBCompAudioProcessor& audioProcessor;
-    
-    //==============================================================================
-    //==============================================================================
-    
-    LookAndFeel lnf;
-    
-    //Placeholder controlBar, analyzer, globalControls, bandControls;
-    ControlBar controlBar;
-    SpectrumAnalyzer analyzer { audioProcessor };
-    GlobalControls globalControls {audioProcessor.apvts};
-    CompressorBandControls bandControls {audioProcessor.apvts};
-    
-    void toggleGlobalBypassState();
-    
-    std::array<juce::AudioParameterBool*, 3> getBypassParams();
-    
-    void updateGlobalBypassButton();
-    
-    //==============================================================================
-    //==============================================================================
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessorEditor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "GUI/LookAndFeel.h"
+#include "GUI/Placeholder.h"
+#include "GUI/GlobalControls.h"
+#include "GUI/CompressorBandControls.h"
+#include "GUI/SpectrumAnalyzer.h"
+#include "GUI/ControlBar.h"
+#include "GUI/GainReductionHistory.h"
+#include "GUI/StereoImageMeter.h"
+#include "GUI/LevelMeters.h"
+#include <map>
+
+
+class SimpleMBCompAudioProcessorEditor  : public juce::AudioProcessorEditor
+{
+public:
+    SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor&);
+    ~SimpleMBCompAudioProcessorEditor() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void paintOverChildren (juce::Graphics&) override;
+    void resized() override;
+    
+    //How long it took from the start of the constructor until the constructor returned,
+    //and until everything had been painted once. Zero until that has happened.
+    struct OpenLatency
+    {
+        double constructionMs = 0.0;
+        double firstPaintMs = 0.0;
+    };
+    
+    const OpenLatency& getOpenLatency() const { return openLatency; }
+    
+    //Everything that animates is driven from here, once per display refresh,
+    //instead of each component running its own timer.
+    //The VBlankAttachment calls it, it can also be called to drive the editor without a display.
+    void vBlankCallback();
+    
+    SpectrumAnalyzer& getAnalyzer() { return analyzer; }
+    
+    //The parts of the editor worth timing on their own, by name, with the whole editor first.
+    //There are many knobs, so one of them stands in for the rest.
+    std::vector<std::pair<juce::String, juce::Component*>> getComponentsToProfile();
+
+private:
+    // This reference is provided as a quick way for your editor to
+    // access the processor object that created it.
+    SimpleMBCompAudioProcessor& audioProcessor;
+    
+    //This has to stay above every component, so it is initialised before any of them are built
+    const juce::int64 openStartTicks { juce::Time::getHighResolutionTicks() };
+    OpenLatency openLatency;
+    
+    //==============================================================================
+    //==============================================================================
+    
+    //One look-and-feel for every editor in the process, so they also share its cached knob images.
+    //It has to outlive the components that use it, so it stays above them.
+    juce::SharedResourcePointer<LookAndFeel> lnf;
+    
+    //Placeholder controlBar, analyzer, globalControls, bandControls;
+    ControlBar controlBar;
+    SpectrumAnalyzer analyzer { audioProcessor };
+    StereoImageMeter stereoImageMeter { analyzer.getStereoImageAnalysis() };
+    GainReductionHistory gainReductionHistory { audioProcessor };
+    LevelMeters levelMeters;
+    GlobalControls globalControls {audioProcessor.apvts};
+    CompressorBandControls bandControls {audioProcessor.apvts};
+    
+    void toggleGlobalBypassState();
+    
+    std::array<juce::AudioParameterBool*, 3> getBypassParams();
+    
+    void updateGlobalBypassButton();
+    
+    //The processor's latest meter readings, copied out once per frame
+    MeterSnapshot meterSnapshot;
+    std::uint32_t meterSnapshotVersion = 0;
+    
+    //Everything was designed at this size, the editor scales from it keeping the same proportions
+    static constexpr int designWidth = 900;
+    static constexpr int designHeight = 810;
+    
+    struct Layout
+    {
+        juce::Rectangle<int> controlBar, bandControls, analyzer, gainReductionHistory, stereoImageMeter, levelMeters, globalControls;
+    };
+    
+    static Layout computeLayout(juce::Rectangle<int> bounds);
+    
+    //Each size is only laid out once, dragging back and forth over the same sizes just looks them up
+    std::map<std::pair<int, int>, Layout> layoutCache;
+    static constexpr size_t maxCachedLayouts = 64;
+    
+    /*
+     While the window is being dragged, the components stretch what they've already rendered
+     instead of rebuilding their caches at every step. A resize counts as over once no new step
+     has come in for liveResizeTimeoutSeconds, which vBlankCallback() checks.
+     */
+    static constexpr double liveResizeTimeoutSeconds = 0.25;
+    bool liveResize = false;
+    juce::int64 lastResizeTicks = 0;
+    
+    void beginLiveResize();
+    void endLiveResize();
+    
+    juce::VBlankAttachment vBlankAttachment { this, [this]() { vBlankCallback(); } };
+    
+    //==============================================================================
+    //==============================================================================
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessorEditor)
+};
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    SharedResourceCache.h
+    Created: 19 Oct 2026 10:05:52pm
+    Author:  Joseph Skonie
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <map>
+
+/*
+ Hands out one shared, immutable instance of a resource per key, to every plugin instance in the process.
+ 
+ The first get() for a key builds it, every get() after that (from any instance, on any thread)
+ returns the same object. How long it lives after that depends on the cache's Lifetime:
+ 
+ - whileUsed: the cache only holds a weak reference, so the resource is freed with its last user.
+   For resources that are big, or that there can be many of.
+ - pinned: the cache keeps it until the process ends, so closing the last editor and opening
+   another one doesn't build it again. For small, fixed sets of resources that are slow to build.
+ 
+ Resources are handed out as const, so once get() has returned, using them needs no locking.
+ Use one cache per kind of resource, usually as a function-local static next to its type.
+ */
+template<typename Key, typename Resource>
+struct SharedResourceCache
+{
+    enum class Lifetime
+    {
+        whileUsed,
+        pinned
+    };
+    
+    explicit SharedResourceCache(Lifetime lifetimeToUse = Lifetime::whileUsed) : lifetime(lifetimeToUse) { }
+    
+    /**
+     Returns the resource for 'key', calling 'create' to build it if nobody is holding one.
+     'create' must return something convertible to std::shared_ptr<const Resource>.
+     It is called with the cache locked, so building one resource holds up other get()s,
+     but two threads asking for the same key never both build it.
+     */
+    template<typename CreateFunction>
+    std::shared_ptr<const Resource> get(const Key& key, CreateFunction&& create)
+    {
+        const juce::ScopedLock sl(lock);
+        
+        auto& entry = entries[key];
+        
+        if( auto existing = entry.resource.lock() )
+            return existing;
+        
+        std::shared_ptr<const Resource> resource = create();
+        entry.resource = resource;
+        
+        if( lifetime == Lifetime::pinned )
+            entry.pin = resource;
+        
+        removeExpiredEntries();
+        return resource;
+    }
+    
+    //How many resources are currently alive, mostly for checking that they are being shared
+    int getNumResources() const
+    {
+        const juce::ScopedLock sl(lock);
+        
+        return static_cast<int>(std::count_if(entries.begin(),
+                                              entries.end(),
+                                              [](const auto& entry) { return ! entry.second.resource.expired(); }));
+    }
+private:
+    struct Entry
+    {
+        std::weak_ptr<const Resource> resource;
+        
+        //only set when the cache is pinned, keeps 'resource' alive without any users
+        std::shared_ptr<const Resource> pin;
+    };
+    
+    const Lifetime lifetime;
+    juce::CriticalSection lock;
+    std::map<Key, Entry> entries;
+    
+    //released resources leave their keys behind, this stops those from piling up
+    void removeExpiredEntries()
+    {
+        for( auto it = entries.begin(); it != entries.end(); )
+        {
+            if( it->second.resource.expired() )
+                it = entries.erase(it);
+            else
+                ++it;
+        }
+    }
+};